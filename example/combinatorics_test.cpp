@@ -0,0 +1,25 @@
+#include <iostream>
+
+#include "modint.hpp"
+
+using namespace std;
+
+/*
+* 表を前計算した範囲より大きい引数で呼び、表を法の近くまで伸ばす。
+*
+* Output
+* C(8, 0) = 1, C(9, 1) = 9, C(10, 2) = 6, C(12, 6) = 1
+* 12! = 12, 12^{-1} = 12
+* 700000 * 700000^{-1} = 1
+*/
+
+int main() {
+  // 表のサイズ8から2倍に伸ばすと法13を超えるが、表は法までしか伸ばさない
+  Combinatorics<ModInt<13>> small(7);
+  cout << "C(8, 0) = " << small.C(8, 0) << ", C(9, 1) = " << small.C(9, 1);
+  cout << ", C(10, 2) = " << small.C(10, 2) << ", C(12, 6) = " << small.C(12, 6) << endl;
+  cout << "12! = " << small.fact(12) << ", 12^{-1} = " << small.inv(12) << endl;
+
+  Combinatorics<ModInt<1000003>> large(600000);
+  cout << "700000 * 700000^{-1} = " << large.inv(700000) * ModInt<1000003>(700000) << endl;
+}
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+#include "contraction_hierarchies.hpp"
+#include "dijkstra.hpp"
+
+using namespace std;
+
+/*
+* ランダムなグラフで，ContractionHierarchiesのquery / pathとDijkstraの結果を全ての頂点対について比べる．
+* saveしてloadした結果でも同じクエリを行い，壊れたファイルのloadが失敗することも確かめる．
+*
+* Output
+* random graphs: 100, mismatches: 0
+* reloaded: 100, mismatches: 0
+* load wrong cost type: failed
+* load truncated file: failed
+* load corrupted arc: failed
+*/
+
+int main() {
+  mt19937 rng(1);
+  int n_graphs = 100, mismatches = 0, reload_mismatches = 0, n_reloaded = 0;
+  string saved;
+  for (int it = 0; it < n_graphs; ++it) {
+    int n = rng() % 30 + 1, m = rng() % 120;
+    vector<tuple<int, int, long long>> edges;
+    vector<vector<pair<int, long long>>> adj(n);
+    for (int i = 0; i < m; ++i) {
+      int u = rng() % n, v = rng() % n;
+      long long c = rng() % 20;
+      edges.emplace_back(u, v, c);
+      adj[u].emplace_back(v, c);
+    }
+    CSRGraph<long long> g(n, edges);
+    ContractionHierarchies<long long> ch(g, it % 3 + 1);
+
+    stringstream ss;
+    ch.save(ss);
+    if (it == 0) saved = ss.str();
+    ContractionHierarchies<long long> reloaded = ContractionHierarchies<long long>::load(ss);
+    if (ss) ++n_reloaded;
+
+    for (int s = 0; s < n; ++s) {
+      Dijkstra<long long> dijkstra(adj, s);
+      for (int t = 0; t < n; ++t) {
+        long long expected = dijkstra.distance_to(t);
+        bool ok = ch.query(s, t) == expected;
+        // 経路は始点から終点へ辺で繋がっていて，重みの和が最短距離に等しい
+        vector<int> path = ch.path(s, t);
+        if (!dijkstra.is_reachable(t)) {
+          ok = ok && path.empty();
+        } else {
+          ok = ok && !path.empty() && path.front() == s && path.back() == t;
+          long long length = 0;
+          for (int i = 0; ok && i + 1 < int(path.size()); ++i) {
+            long long best = -1;
+            for (auto [v, c] : adj[path[i]]) {
+              if (v == path[i + 1] && (best == -1 || c < best)) best = c;
+            }
+            ok = best != -1;
+            length += best;
+          }
+          ok = ok && length == expected;
+        }
+        if (!ok) ++mismatches;
+        if (reloaded.query(s, t) != expected) ++reload_mismatches;
+      }
+    }
+  }
+  cout << "random graphs: " << n_graphs << ", mismatches: " << mismatches << endl;
+  cout << "reloaded: " << n_reloaded << ", mismatches: " << reload_mismatches << endl;
+
+  auto try_load = [](const string &name, const string &data, bool as_int) {
+    stringstream ss(data);
+    if (as_int) {
+      ContractionHierarchies<int>::load(ss);
+    } else {
+      ContractionHierarchies<long long>::load(ss);
+    }
+    cout << "load " << name << ": " << (ss.fail() ? "failed" : "succeeded") << endl;
+  };
+  try_load("wrong cost type", saved, true);
+  try_load("truncated file", saved.substr(0, saved.size() - 1), false);
+  // 末尾の辺(down_の最後の要素)の行き先を範囲外にする
+  string corrupted = saved;
+  int bad_to = 1 << 30;
+  corrupted.replace(corrupted.size() - sizeof(ContractionHierarchies<long long>::Arc), sizeof(int),
+                    reinterpret_cast<const char *>(&bad_to), sizeof(int));
+  try_load("corrupted arc", corrupted, false);
+}
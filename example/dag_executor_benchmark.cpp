@@ -0,0 +1,94 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dag_executor.hpp"
+#include "topological_sort.hpp"
+
+using namespace std;
+
+/*
+* Usage
+* ./dag_executor_benchmark [n] [work] [n_threads]
+*
+* n頂点のランダムなDAGの各頂点で，work回の計算を行う小さいタスクを実行する．
+* TopologicalSortの順に1スレッドで実行した場合と，DagExecutorをスレッド数1, 2, 4, ..., n_threadsで実行した場合の
+* 時間を比べる．トポロジカルソートは計測に含めない．結果(各タスクの値の和)が一致しなければmismatchと表示する．
+* parallelismは全タスクのコストの和 / 最長路のコストの和で，スレッド数を増やして得られる速度向上の上限．
+* CRITICAL_PATHはヒープの操作が増えるので，タスクが小さく均一な場合はNONEより遅い．
+*
+* Output (n = 1000000, work = 100, n_threads = 4，1コアの環境での例．時間は環境による)
+* sequential: 0.124232s
+* parallelism: 140.213
+* DagExecutor (NONE, 1 threads): 0.272313s
+* DagExecutor (CRITICAL_PATH, 1 threads): 0.503791s
+* DagExecutor (NONE, 2 threads): 0.302061s
+* DagExecutor (CRITICAL_PATH, 2 threads): 0.408123s
+* DagExecutor (NONE, 4 threads): 0.299547s
+* DagExecutor (CRITICAL_PATH, 4 threads): 0.39967s
+* 1コアではスレッドが交互に動くだけなので速くならない．複数のコアがあれば，parallelismとコア数の小さい方を上限として
+* 実行時間がスレッド数に応じて短くなる．
+*/
+
+template <class F>
+double measure(F f) {
+  auto start = chrono::steady_clock::now();
+  f();
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[]) {
+  int n = argc > 1 ? atoi(argv[1]) : 1000000;
+  int work = argc > 2 ? atoi(argv[2]) : 100;
+  int n_threads = argc > 3 ? atoi(argv[3]) : max(1u, thread::hardware_concurrency());
+
+  // 各頂点から，番号の大きい近くの頂点へ平均3本の辺を張る
+  mt19937 rng(0);
+  vector<pair<int, int>> edges;
+  for (int u = 0; u < n; ++u) {
+    for (int k = 0; k < 3; ++k) {
+      int v = u + 1 + rng() % 1000;
+      if (v < n) edges.emplace_back(u, v);
+    }
+  }
+  CSRGraph<> g(n, edges);
+
+  vector<unsigned> value(n);
+  auto task = [&](int v) {
+    unsigned x = v;
+    for (int i = 0; i < work; ++i) x = x * 1103515245 + 12345;
+    value[v] = x;
+  };
+  auto checksum = [&] {
+    unsigned long long sum = 0;
+    for (unsigned x : value) sum += x;
+    return sum;
+  };
+
+  vector<int> order = TopologicalSort(g).sorted();
+  double time = measure([&] {
+    for (int v : order) task(v);
+  });
+  unsigned long long expected = checksum();
+  cout << "sequential: " << time << "s" << endl;
+
+  long long longest = 0;
+  DagExecutor critical(g, 1, DagExecutor::Priority::CRITICAL_PATH);
+  for (int v = 0; v < n; ++v) longest = max(longest, critical.critical_path(v));
+  cout << "parallelism: " << double(n) / longest << endl;
+
+  for (int t = 1;; t = min(2 * t, n_threads)) {
+    for (auto priority : {DagExecutor::Priority::NONE, DagExecutor::Priority::CRITICAL_PATH}) {
+      fill(value.begin(), value.end(), 0);
+      DagExecutor executor(g, t, priority);
+      time = measure([&] { executor.run(task); });
+      cout << "DagExecutor (" << (priority == DagExecutor::Priority::NONE ? "NONE" : "CRITICAL_PATH") << ", " << t
+           << " threads): " << time << "s" << (checksum() == expected ? "" : ", mismatch") << endl;
+    }
+    if (t >= n_threads) break;
+  }
+}
@@ -0,0 +1,69 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "delta_stepping.hpp"
+#include "dijkstra.hpp"
+
+using namespace std;
+
+/*
+* Usage
+* ./delta_stepping_benchmark [n] [m] [max_cost]
+*
+* ランダムな有向グラフ上で，逐次のDijkstra, CSRDijkstraとスレッド数を変えたDeltaSteppingの実行時間を比べる．
+* DeltaSteppingの距離が逐次の結果と一致しなければmismatchと表示する．
+*
+* Output (n = 1000000, m = 8000000, max_cost = 1000000，1コアの環境での例)
+* Dijkstra: 2.79139s
+* CSRDijkstra: 2.07847s
+* DeltaStepping (1 threads): 0.85327s, delta = 125000, phases = 133
+* 複数のコアがあれば，スレッド数を2倍ずつhardware_concurrency()まで増やして計測する．
+*/
+
+template <class F>
+double measure(F f) {
+  auto start = chrono::steady_clock::now();
+  f();
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[]) {
+  int n = argc > 1 ? atoi(argv[1]) : 1000000;
+  int m = argc > 2 ? atoi(argv[2]) : 8 * n;
+  long long max_cost = argc > 3 ? atoll(argv[3]) : 1000000;
+
+  mt19937_64 rng(0);
+  vector<tuple<int, int, long long>> edges(m);
+  vector<vector<pair<int, long long>>> adj(n);
+  for (auto &[u, v, c] : edges) {
+    u = rng() % n;
+    v = rng() % n;
+    c = rng() % (max_cost + 1);
+    adj[u].emplace_back(v, c);
+  }
+  CSRGraph<long long> g(n, edges);
+
+  vector<long long> expected(n);
+  cout << "Dijkstra: " << measure([&] {
+    Dijkstra<long long> dijkstra(adj, 0);
+    for (int v = 0; v < n; ++v) expected[v] = dijkstra.distance_to(v);
+  }) << "s" << endl;
+
+  CSRDijkstra<long long> csr_dijkstra(g);
+  cout << "CSRDijkstra: " << measure([&] { csr_dijkstra.solve(0); }) << "s" << endl;
+
+  int max_threads = max(1u, thread::hardware_concurrency());
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    DeltaStepping<long long> delta_stepping(g, 0, threads);
+    double time = measure([&] { delta_stepping.solve(0); });
+    bool ok = true;
+    for (int v = 0; v < n; ++v) ok &= delta_stepping.distance_to(v) == expected[v];
+    cout << "DeltaStepping (" << threads << " threads): " << time << "s, delta = " << delta_stepping.delta()
+         << ", phases = " << delta_stepping.phase_count() << (ok ? "" : ", mismatch") << endl;
+  }
+}
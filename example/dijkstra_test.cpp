@@ -0,0 +1,113 @@
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "dijkstra.hpp"
+
+using namespace std;
+
+/*
+* 20 × 20のグリッド(隣接するマスの間に重み1以上9以下の辺を両向きに張る)で，各種の最短路をDijkstraの結果と比べる．
+* 2点間の探索は始点を7つおきに選んで全ての終点と比べる．settledは確定させた頂点数で，(0, 0)から(10, 10)への結果．
+*
+* Output
+* CSRDijkstra: sources = 400, mismatches = 0
+* RadixHeap: sources = 400, mismatches = 0
+* distance (0, 0) -> (10, 10) = 59
+* full: settled = 400
+* early exit: settled = 159, mismatches = 0
+* A*: settled = 124, mismatches = 0
+* bidirectional: settled = 125, mismatches = 0
+* multi-source: mismatches = 0
+* distance_matrix: mismatches = 0
+*/
+
+int main() {
+  const int h = 20, w = 20, n = h * w;
+  auto id = [w](int y, int x) { return y * w + x; };
+  mt19937 rng(0);
+  vector<tuple<int, int, int>> edges;
+  vector<vector<pair<int, int>>> adj(n);
+  for (int y = 0; y < h; ++y) {
+    for (int x = 0; x < w; ++x) {
+      int nbr[2][2] = {{y + 1, x}, {y, x + 1}};
+      for (auto [ny, nx] : nbr) {
+        if (ny >= h || nx >= w) continue;
+        int c = rng() % 9 + 1;
+        for (auto [u, v] : {make_pair(id(y, x), id(ny, nx)), make_pair(id(ny, nx), id(y, x))}) {
+          edges.emplace_back(u, v, c);
+          adj[u].emplace_back(v, c);
+        }
+      }
+    }
+  }
+  CSRGraph<int> g(n, edges);
+  vector<Dijkstra<int>> expected;
+  for (int s = 0; s < n; ++s) expected.emplace_back(adj, s);
+
+  // 全ての始点からの最短距離．作業用の配列は使い回す
+  CSRDijkstra<int> dijkstra(g);
+  CSRDijkstra<int, RadixHeap<int>> radix(g);
+  int mismatches = 0, radix_mismatches = 0;
+  for (int s = 0; s < n; ++s) {
+    dijkstra.solve(s);
+    radix.solve(s);
+    for (int t = 0; t < n; ++t) {
+      if (dijkstra.distance_to(t) != expected[s].distance_to(t)) ++mismatches;
+      if (radix.distance_to(t) != expected[s].distance_to(t)) ++radix_mismatches;
+    }
+  }
+  cout << "CSRDijkstra: sources = " << n << ", mismatches = " << mismatches << endl;
+  cout << "RadixHeap: sources = " << n << ", mismatches = " << radix_mismatches << endl;
+
+  // 2点間の探索．A*のヒューリスティックは重みの最小値1 × マンハッタン距離
+  int src = id(0, 0), dst = id(10, 10);
+  dijkstra.solve(src);
+  cout << "distance (0, 0) -> (10, 10) = " << dijkstra.distance_to(dst) << endl;
+  cout << "full: settled = " << dijkstra.settled_count() << endl;
+  CSRGraph<int> rev_g = g.reversed();
+  BidirectionalDijkstra<int> bidirectional(g, rev_g);
+  int early_mismatches = 0, astar_mismatches = 0, bidirectional_mismatches = 0;
+  int early_settled = 0, astar_settled = 0, bidirectional_settled = 0;
+  for (int s = 0; s < n; s += 7) {
+    for (int t = 0; t < n; ++t) {
+      auto heuristic = [&](int v) { return abs(v / w - t / w) + abs(v % w - t % w); };
+      dijkstra.solve(s, t);
+      if (dijkstra.distance_to(t) != expected[s].distance_to(t)) ++early_mismatches;
+      if (s == src && t == dst) early_settled = dijkstra.settled_count();
+      dijkstra.solve_astar(s, t, heuristic);
+      if (dijkstra.distance_to(t) != expected[s].distance_to(t)) ++astar_mismatches;
+      if (s == src && t == dst) astar_settled = dijkstra.settled_count();
+      bidirectional.solve(s, t);
+      if (bidirectional.distance_to(t) != expected[s].distance_to(t)) ++bidirectional_mismatches;
+      if (s == src && t == dst) bidirectional_settled = bidirectional.settled_count();
+    }
+  }
+  cout << "early exit: settled = " << early_settled << ", mismatches = " << early_mismatches << endl;
+  cout << "A*: settled = " << astar_settled << ", mismatches = " << astar_mismatches << endl;
+  cout << "bidirectional: settled = " << bidirectional_settled << ", mismatches = " << bidirectional_mismatches << endl;
+
+  // 複数の始点からの距離は，各始点からの距離の最小値
+  vector<int> sources = {id(0, 0), id(5, 17), id(19, 3)};
+  dijkstra.solve(sources);
+  int multi_mismatches = 0;
+  for (int t = 0; t < n; ++t) {
+    int best = expected[sources[0]].distance_to(t);
+    for (int s : sources) best = min(best, expected[s].distance_to(t));
+    if (dijkstra.distance_to(t) != best || expected[dijkstra.source_of(t)].distance_to(t) != best) ++multi_mismatches;
+  }
+  cout << "multi-source: mismatches = " << multi_mismatches << endl;
+
+  // 距離行列は2スレッドで求める
+  vector<int> targets = {id(19, 19), id(10, 10), id(0, 19)};
+  vector<int> matrix = distance_matrix(g, sources, targets, 2);
+  int matrix_mismatches = 0;
+  for (size_t i = 0; i < sources.size(); ++i) {
+    for (size_t j = 0; j < targets.size(); ++j) {
+      if (matrix[i * targets.size() + j] != expected[sources[i]].distance_to(targets[j])) ++matrix_mismatches;
+    }
+  }
+  cout << "distance_matrix: mismatches = " << matrix_mismatches << endl;
+}
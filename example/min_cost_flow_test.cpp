@@ -0,0 +1,87 @@
+#include <iostream>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "min_cost_flow.hpp"
+
+using namespace std;
+
+/*
+* Graph (容量, 費用)
+*         (1)
+*        ^ | \
+*  (2, 1)/ |  \(1, 3)
+*      /   |   v
+*   (0)  (1, 1) (3)
+*      \   |   ^
+*  (1, 2)\ |  /(2, 1)
+*        v v /
+*         (2)
+*
+* 0から3へ流す．費用3の経路0 -> 1 -> 2 -> 3と0 -> 2 -> 3に1ずつ流した後，費用4の経路0 -> 1 -> 3に1流す．
+* 2つ目のグラフは1つ目の辺2 -> 3の費用を-2にしたもので，Bellman-Ford法でポテンシャルを求めてから流す．最後にランダムなDAG(負の費用の辺を含む)で，
+* flowとflow_cost_scalingの結果が一致するかを調べる．
+*
+* Output
+* slope: (0, 0) (2, 6) (3, 10)
+* flow: (3, 10), flow_cost_scaling: (3, 10)
+* edge 0 -> 1: 2 / 2
+* edge 0 -> 2: 1 / 1
+* edge 1 -> 2: 1 / 1
+* edge 1 -> 3: 1 / 1
+* edge 2 -> 3: 2 / 2
+* negative cost slope: (0, 0) (2, 0) (3, 4)
+* negative cost flow: (3, 4), flow_cost_scaling: (3, 4)
+* random DAGs: 200, mismatches: 0
+*/
+
+vector<tuple<int, int, int, int>> make_graph(int cost_2_3) {
+  return {{0, 1, 2, 1}, {0, 2, 1, 2}, {1, 2, 1, 1}, {1, 3, 1, 3}, {2, 3, 2, cost_2_3}};
+}
+
+template <class Graph>
+MinCostFlow<int, long long> build(int n, const Graph &edges) {
+  MinCostFlow<int, long long> mcf(n);
+  for (auto [from, to, cap, cost] : edges) mcf.add_edge(from, to, cap, cost);
+  return mcf;
+}
+
+void run(const string &prefix, int cost_2_3, bool print_edges) {
+  auto edges = make_graph(cost_2_3);
+  MinCostFlow<int, long long> primal_dual = build(4, edges), cost_scaling = build(4, edges);
+  cout << prefix << "slope:";
+  for (auto [f, c] : primal_dual.slope(0, 3)) cout << " (" << f << ", " << c << ")";
+  cout << endl;
+  auto [flow, cost] = build(4, edges).flow(0, 3);
+  auto [flow_cs, cost_cs] = cost_scaling.flow_cost_scaling(0, 3);
+  cout << prefix << "flow: (" << flow << ", " << cost << "), flow_cost_scaling: (" << flow_cs << ", " << cost_cs << ")"
+       << endl;
+  if (!print_edges) return;
+  for (int i = 0; i < int(edges.size()); ++i) {
+    auto e = primal_dual.get_edge(i);
+    cout << "edge " << e.from << " -> " << e.to << ": " << e.flow << " / " << e.cap << endl;
+  }
+}
+
+int main() {
+  run("", 1, true);
+  run("negative cost ", -2, false);
+
+  mt19937 rng(0);
+  int n_graphs = 200, mismatches = 0;
+  for (int it = 0; it < n_graphs; ++it) {
+    int n = rng() % 8 + 2, m = rng() % 25;
+    vector<tuple<int, int, int, int>> edges;
+    for (int i = 0; i < m; ++i) {
+      int u = rng() % n, v = rng() % n;
+      if (u == v) continue;
+      if (u > v) swap(u, v);
+      edges.emplace_back(u, v, rng() % 5 + 1, int(rng() % 16) - 5);
+    }
+    auto a = build(n, edges).flow(0, n - 1);
+    auto b = build(n, edges).flow_cost_scaling(0, n - 1);
+    if (a != b) ++mismatches;
+  }
+  cout << "random DAGs: " << n_graphs << ", mismatches: " << mismatches << endl;
+}
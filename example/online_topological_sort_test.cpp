@@ -0,0 +1,35 @@
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "online_topological_sort.hpp"
+
+using namespace std;
+
+/*
+* 頂点0, 1, 2, 3, 4に辺を1本ずつ追加し，その度に順序を表示する．
+* 3 -> 1，1 -> 2，4 -> 0は今の順序に逆らうので，位置が1から3，2から3，0から4の範囲にある頂点だけを並べ替える．最後の2 -> 4で閉路4 -> 0 -> 1 -> 2 -> 4ができる．
+*
+* Output
+* initial: 0 1 2 3 4 
+* add 0 -> 1: sortable = 1, order: 0 1 2 3 4 
+* add 3 -> 1: sortable = 1, order: 0 3 2 1 4 
+* add 1 -> 2: sortable = 1, order: 0 3 1 2 4 
+* add 4 -> 0: sortable = 1, order: 4 3 0 1 2 
+* add 2 -> 4: sortable = 0, order: 
+*/
+
+int main() {
+  OnlineTopologicalSort ots(5);
+  cout << "initial: ";
+  for (int v : ots.sorted()) cout << v << " ";
+  cout << endl;
+
+  vector<pair<int, int>> edges = {{0, 1}, {3, 1}, {1, 2}, {4, 0}, {2, 4}};
+  for (auto [from, to] : edges) {
+    ots.add_edge(from, to);
+    cout << "add " << from << " -> " << to << ": sortable = " << ots.is_sortable() << ", order: ";
+    for (int v : ots.sorted()) cout << v << " ";
+    cout << endl;
+  }
+}
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <string>
 
 #include "prime_number.hpp"
 
@@ -8,6 +9,18 @@ using namespace std;
 * Output
 * Is Prime: 0 0 1 1 0 1 0 1 0 0 0
 * Prime Numbers: 2 3 5 7
+* Segmented [999900, 1000000]: 999907 999917 999931 999953 999959 999961 999979 999983
+* Segmented count [999900, 1000000]: 8, pi(10^6) = 78498
+* x:       1 2 3 4 5 6 7 8 9 10 11 12
+* spf:     1 2 3 2 5 2 7 2 3 2 11 2
+* phi:     1 1 2 2 4 2 6 4 6 4 10 4
+* mu:      1 -1 -1 0 -1 1 -1 0 0 1 -1 0
+* divisor: 1 2 2 3 2 4 2 4 3 4 2 6
+* 360 = 2^3 3^2 5^1
+* 3215031751: prime = 0, factors = 151^1 751^1 28351^1
+* 998244359987710471: prime = 0, factors = 998244353^1 1000000007^1
+* 18446743979220271189: prime = 0, factors = 4294967279^1 4294967291^1
+* 18446744073709551557: prime = 1, factors = 18446744073709551557^1
 */
 
 int main() {
@@ -25,4 +38,40 @@ int main() {
   for (int i = 0; i < m; ++i) {
     cout << prime_nums[i] << (i < m - 1 ? " " : "\n");
   }
+
+  // 区間の篩は[lo, n]だけを篩う．小さい区間に分けて2スレッドで篩っても結果は同じ
+  long long lo = 999900, hi = 1000000;
+  SegmentedSieve sieve(hi, 2, 64, 2);
+  cout << "Segmented [" << lo << ", " << hi << "]:";
+  sieve.for_each(lo, [](long long p) { cout << " " << p; });
+  cout << endl;
+  cout << "Segmented count [" << lo << ", " << hi << "]: " << sieve.count(lo) << ", pi(10^6) = " << sieve.count()
+       << endl;
+
+  // 線形篩の最小素因数，φ関数，メビウス関数，約数の個数の表
+  int k = 12;
+  LinearSieve linear(k);
+  vector<int> phi = linear.phi_table(), mu = linear.mobius_table(), divisors = linear.divisor_count_table();
+  auto print_row = [k](const string &name, auto f) {
+    cout << name;
+    for (int x = 1; x <= k; ++x) cout << f(x) << (x < k ? " " : "\n");
+  };
+  print_row("x:       ", [](int x) { return x; });
+  print_row("spf:     ", [&](int x) { return linear.smallest_prime_factor(x); });
+  print_row("phi:     ", [&](int x) { return phi[x]; });
+  print_row("mu:      ", [&](int x) { return mu[x]; });
+  print_row("divisor: ", [&](int x) { return divisors[x]; });
+  LinearSieve linear_360(360);
+  cout << "360 =";
+  for (auto [p, e] : linear_360.factorize(360)) cout << " " << p << "^" << e;
+  cout << endl;
+
+  // 64bit整数の素数判定と素因数分解．2^63以上の値はMontgomery乗算を使わない経路になる
+  // 3215031751は底2, 3, 5, 7に対する強擬素数
+  for (unsigned long long x : {3215031751ULL, 998244353ULL * 1000000007ULL, 4294967291ULL * 4294967279ULL,
+                               18446744073709551557ULL}) {
+    cout << x << ": prime = " << miller_rabin(x) << ", factors =";
+    for (auto [p, e] : pollard_rho_factorize(x)) cout << " " << p << "^" << e;
+    cout << endl;
+  }
 }
\ No newline at end of file
@@ -16,6 +16,16 @@ using namespace std;
 *
 * Output
 * 0 7 1 3 4 2 6 5 8 9 
+* Lexicographic: 0 1 3 2 7 4 6 5 8 9 
+* Layers: 7
+* layer 0: 0 7 
+* layer 1: 1 3 4 
+* layer 2: 2 
+* layer 3: 6 
+* layer 4: 5 
+* layer 5: 8 
+* layer 6: 9 
+* Cycle: sortable = 0, layers = 0
 */
 
 int main() {
@@ -40,4 +50,27 @@ int main() {
     cout << *iter << " ";
   }
   cout << endl;
+
+  // 入次数が0の頂点のうち番号が最小のものから取り出す
+  TopologicalSort lex(graph, TopologicalSort::Order::LEXICOGRAPHIC);
+  cout << "Lexicographic: ";
+  for (int v : lex.sorted()) {
+    cout << v << " ";
+  }
+  cout << endl;
+
+  // 同じ層の頂点の間には辺がない
+  cout << "Layers: " << tpl.layer_count() << endl;
+  for (int i = 0; i < tpl.layer_count(); ++i) {
+    cout << "layer " << i << ": ";
+    for (int v : tpl.layer(i)) {
+      cout << v << " ";
+    }
+    cout << endl;
+  }
+
+  // 辺9 -> 6を加えると閉路6 -> 5 -> 8 -> 9 -> 6ができる
+  graph[9].push_back(6);
+  TopologicalSort cyclic(graph);
+  cout << "Cycle: sortable = " << cyclic.is_sortable() << ", layers = " << cyclic.layer_count() << endl;
 }
\ No newline at end of file
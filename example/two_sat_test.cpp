@@ -0,0 +1,45 @@
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+#include "two_sat.hpp"
+
+using namespace std;
+
+/*
+* 1つ目: (x0 ∨ x1) ∧ (¬x0 ∨ x2) ∧ (¬x1 ∨ ¬x2) ∧ (x0 ∨ ¬x2) ∧ (¬x1 ∨ x3)
+* 2つ目: (x0 ∨ x0) ∧ (¬x0 ∨ x1) ∧ (¬x0 ∨ ¬x1)
+*
+* Output
+* satisfiable: 1
+* x0 = 0, x1 = 1, x2 = 0, x3 = 1
+* (x0 ∨ x1): 1
+* (¬x0 ∨ x2): 1
+* (¬x1 ∨ ¬x2): 1
+* (x0 ∨ ¬x2): 1
+* (¬x1 ∨ x3): 1
+* satisfiable: 0
+*/
+
+// (変数，値，変数，値)で節を表す
+using Clause = tuple<int, bool, int, bool>;
+
+void solve(int n, const vector<Clause> &clauses) {
+  TwoSat ts(n);
+  for (auto [i, f, j, g] : clauses) ts.add_clause(i, f, j, g);
+  bool ok = ts.satisfiable();
+  cout << "satisfiable: " << ok << endl;
+  if (!ok) return;
+
+  const vector<bool> &x = ts.answer();
+  for (int i = 0; i < n; ++i) cout << "x" << i << " = " << x[i] << (i < n - 1 ? ", " : "\n");
+  for (auto [i, f, j, g] : clauses) {
+    cout << "(" << (f ? "" : "¬") << "x" << i << " ∨ " << (g ? "" : "¬") << "x" << j << "): ";
+    cout << (x[i] == f || x[j] == g) << endl;
+  }
+}
+
+int main() {
+  solve(4, {{0, true, 1, true}, {0, false, 2, true}, {1, false, 2, false}, {0, true, 2, false}, {1, false, 3, true}});
+  solve(2, {{0, true, 0, true}, {0, false, 1, true}, {0, false, 1, false}});
+}
@@ -0,0 +1,213 @@
+#pragma once
+/**
+ * @file binomial_mod.hpp
+ * @brief 巨大なnに対する二項係数を小さい法で求めるコード。
+ * @details
+ * * LucasBinomial
+ *   * 素数pを法とする。サイズpの表を前計算し、Lucasの定理によりO(log_p n)で求める。
+ * * PrimePowerBinomial
+ *   * 素数冪p^eを法とする。サイズp^eの表を前計算し、Granvilleの方法によりO(log_p n + e log p)で求める。
+ *   * n!からpの因数を除いた値を、p^eを周期とする積の表の積に分解する。
+ * * BinomialMod
+ *   * 任意の法mを素数冪に分解し、各素数冪での結果を中国剰余定理で復元する。
+ *   * 表のサイズの合計はm以下。各素数冪は2^31未満である必要がある。
+ * * n, kは0以上10^18程度まで扱える。
+ */
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace binomial_mod_internal {
+
+/**
+ * @brief 拡張ユークリッドの互除法でa^{-1} mod mを求める。gcd(a, m) = 1が必要。
+ */
+inline long long inv_mod(long long a, long long m) {
+  long long b = m, u = 1, v = 0;
+  a %= m;
+  if (a < 0) a += m;
+  while (b) {
+    long long t = a / b;
+    a -= t * b;
+    std::swap(a, b);
+    u -= t * v;
+    std::swap(u, v);
+  }
+  assert(a == 1);
+  u %= m;
+  return u < 0 ? u + m : u;
+}
+
+} // namespace binomial_mod_internal
+
+/**
+ * @brief 素数を法とする二項係数をLucasの定理で求めるクラス。
+ */
+class LucasBinomial {
+public:
+  /**
+   * @brief LucasBinomialクラスのコンストラクタ。O(p)
+   * @param p 法とする素数。2^31未満。
+   */
+  explicit LucasBinomial(int p) : p_(p), fact_(p), inv_fact_(p) {
+    fact_[0] = 1;
+    for (int i = 1; i < p_; ++i) fact_[i] = static_cast<long long>(fact_[i - 1]) * i % p_;
+    inv_fact_[p_ - 1] = binomial_mod_internal::inv_mod(fact_[p_ - 1], p_);
+    for (int i = p_ - 1; i > 0; --i) inv_fact_[i - 1] = static_cast<long long>(inv_fact_[i]) * i % p_;
+  }
+
+  int mod() const {
+    return p_;
+  }
+
+  /**
+   * @brief n choose k mod pを求める。O(log_p n)
+   */
+  long long operator()(long long n, long long k) const {
+    if (n < 0 || k < 0 || n < k) return 0;
+    long long ret = 1;
+    while (k > 0) {
+      int ni = n % p_, ki = k % p_;
+      if (ni < ki) return 0;
+      ret = ret * fact_[ni] % p_ * inv_fact_[ki] % p_ * inv_fact_[ni - ki] % p_;
+      n /= p_;
+      k /= p_;
+    }
+    return ret;
+  }
+
+private:
+  int p_;
+  std::vector<int> fact_, inv_fact_;
+};
+
+/**
+ * @brief 素数冪を法とする二項係数を求めるクラス。
+ */
+class PrimePowerBinomial {
+public:
+  /**
+   * @brief PrimePowerBinomialクラスのコンストラクタ。O(p^e)
+   * @param p 素数。
+   * @param e 指数。p^eは2^31未満。
+   */
+  PrimePowerBinomial(int p, int e) : p_(p), e_(e), pe_(1) {
+    for (int i = 0; i < e_; ++i) pe_ *= p_;
+    assert(pe_ < (1LL << 31));
+    // 1からp^eまでのpの倍数を除いた積は、p = 2, e >= 3のとき1、それ以外のとき-1
+    period_sign_ = (p_ == 2 && e_ >= 3) ? 1 : -1;
+    fact_.resize(pe_);
+    fact_[0] = 1;
+    for (long long i = 1; i < pe_; ++i) {
+      fact_[i] = (i % p_ == 0) ? fact_[i - 1] : static_cast<int>(fact_[i - 1] * i % pe_);
+    }
+  }
+
+  long long mod() const {
+    return pe_;
+  }
+
+  /**
+   * @brief n choose k mod p^eを求める。O(log_p n + e log p)
+   */
+  long long operator()(long long n, long long k) const {
+    if (n < 0 || k < 0 || n < k) return 0;
+    long long r = n - k;
+    // 各階乗のpの指数と、pを除いた部分の積を同時に求める
+    long long num = 1, den = 1;
+    long long v = 0, sign_exp = 0;
+    for (long long a = n, b = k, c = r; a > 0; a /= p_, b /= p_, c /= p_) {
+      num = num * fact_[a % pe_] % pe_;
+      den = den * fact_[b % pe_] % pe_ * fact_[c % pe_] % pe_;
+      sign_exp += a / pe_ - b / pe_ - c / pe_;
+      v += a / p_ - b / p_ - c / p_;
+    }
+    if (v >= e_) return 0;
+
+    long long ret = num * binomial_mod_internal::inv_mod(den, pe_) % pe_;
+    if (period_sign_ == -1 && (sign_exp & 1)) ret = (pe_ - ret) % pe_;
+    for (long long i = 0; i < v; ++i) ret = ret * p_ % pe_;
+    return ret;
+  }
+
+private:
+  int p_, e_;
+  long long pe_;
+  int period_sign_;
+  std::vector<int> fact_;
+};
+
+/**
+ * @brief 任意の法に対する二項係数を、素数冪ごとの結果を中国剰余定理で組み合わせて求めるクラス。
+ */
+class BinomialMod {
+public:
+  /**
+   * @brief BinomialModクラスのコンストラクタ。mを試し割りで素因数分解し、各素数冪の表を構築する。
+   * @param m 法。1以上。
+   */
+  explicit BinomialMod(long long m) : m_(m) {
+    assert(m_ >= 1);
+    long long rest = m_;
+    for (long long p = 2; p * p <= rest; ++p) {
+      if (rest % p != 0) continue;
+      int e = 0;
+      while (rest % p == 0) {
+        rest /= p;
+        ++e;
+      }
+      add_prime_power_(p, e);
+    }
+    if (rest > 1) add_prime_power_(rest, 1);
+  }
+
+  long long mod() const {
+    return m_;
+  }
+
+  /**
+   * @brief n choose k mod mを求める。O(Σ log_p n)
+   */
+  long long operator()(long long n, long long k) const {
+    if (m_ == 1 || n < 0 || k < 0 || n < k) return 0;
+    unsigned __int128 ret = 0;
+    for (std::size_t i = 0; i < moduli_.size(); ++i) {
+      long long r = engines_[i].is_lucas ? lucas_[engines_[i].id](n, k) : prime_power_[engines_[i].id](n, k);
+      ret += static_cast<unsigned __int128>(r) * crt_coef_[i];
+    }
+    return static_cast<long long>(ret % m_);
+  }
+
+private:
+  struct Engine {
+    bool is_lucas;
+    int id;
+  };
+
+  long long m_;
+  std::vector<LucasBinomial> lucas_;
+  std::vector<PrimePowerBinomial> prime_power_;
+  std::vector<Engine> engines_;
+  std::vector<long long> moduli_;
+  // (m / pe) * ((m / pe)^{-1} mod pe) mod m
+  std::vector<long long> crt_coef_;
+
+  void add_prime_power_(long long p, int e) {
+    long long pe = 1;
+    for (int i = 0; i < e; ++i) pe *= p;
+    if (e == 1) {
+      engines_.push_back(Engine{true, static_cast<int>(lucas_.size())});
+      lucas_.emplace_back(static_cast<int>(p));
+    } else {
+      engines_.push_back(Engine{false, static_cast<int>(prime_power_.size())});
+      prime_power_.emplace_back(static_cast<int>(p), e);
+    }
+    moduli_.push_back(pe);
+    long long rest = m_ / pe;
+    long long coef = static_cast<long long>(
+      static_cast<unsigned __int128>(rest) * binomial_mod_internal::inv_mod(rest % pe, pe) % m_
+    );
+    crt_coef_.push_back(coef);
+  }
+};
@@ -0,0 +1,147 @@
+#pragma once
+/**
+ * @file bucket_queue.hpp
+ * @brief 重みが小さい整数の場合の単調優先度付きキューに関するコード。
+ * @details
+ * * ZeroOneQueue
+ *   * 0-1 BFS用の両端キュー。キーは最後に取り出したキーかその+1のみ挿入できる。
+ *   * push, popともにO(1)。
+ * * DialQueue
+ *   * Dial法のバケットキュー。キー毎のバケットを循環配列で持つ。
+ *   * 最後に取り出したキーとの差がバケット数以上のキーが来たらバケット数を2倍にする。
+ *   * Cを重みの最大値，Dを最大の距離として，Dijkstra法全体でO(M + D)。
+ * * いずれもdecrease-keyは持たないので，取り出した側で古い値を読み飛ばす。
+ */
+
+#include <cassert>
+#include <deque>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 0-1 BFS用の両端キュー。
+ * @tparam Key 整数のキーの型。
+ */
+template <typename Key>
+class ZeroOneQueue {
+public:
+  explicit ZeroOneQueue(int = 0) {}
+
+  void resize(int) { clear(); }
+
+  bool empty() const { return dq_.empty(); }
+  int size() const { return dq_.size(); }
+
+  /**
+   * @brief (key, v)を挿入する。keyは最後に取り出したキーか，その+1である必要がある。
+   */
+  void push(Key key, int v) {
+    if (key == last_) {
+      dq_.emplace_front(key, v);
+    } else {
+      assert(key == last_ + 1);
+      dq_.emplace_back(key, v);
+    }
+  }
+
+  std::pair<Key, int> pop() {
+    assert(!dq_.empty());
+    std::pair<Key, int> ret = dq_.front();
+    dq_.pop_front();
+    last_ = ret.first;
+    return ret;
+  }
+
+  void clear() {
+    dq_.clear();
+    last_ = 0;
+  }
+
+private:
+  std::deque<std::pair<Key, int>> dq_;
+  Key last_ = 0;
+};
+
+/**
+ * @brief Dial法のバケットキュー。
+ * @tparam Key 非負整数のキーの型。
+ */
+template <typename Key>
+class DialQueue {
+public:
+  /**
+   * @brief 初期のバケット数は，max_diff + 1以上の2冪。
+   *
+   * @param max_diff 挿入するキーと最後に取り出したキーの差の最大値の見込み。Dijkstra法では重みの最大値。
+   */
+  explicit DialQueue(int = 0, Key max_diff = 1) {
+    reserve(max_diff);
+  }
+
+  /**
+   * @brief キーの差がmax_diffまでならバケット数を変えずに済むようにする。
+   */
+  void reserve(Key max_diff) {
+    std::size_t n_buckets = 1;
+    while (n_buckets <= static_cast<std::size_t>(max_diff)) n_buckets *= 2;
+    if (n_buckets > buckets_.size()) grow_(n_buckets);
+  }
+
+  void resize(int) { clear(); }
+
+  bool empty() const { return size_ == 0; }
+  int size() const { return size_; }
+
+  /**
+   * @brief (key, v)を挿入する。keyは最後に取り出したキー以上である必要がある。
+   */
+  void push(Key key, int v) {
+    assert(key >= cur_);
+    if (static_cast<std::size_t>(key - cur_) >= buckets_.size()) {
+      std::size_t n_buckets = buckets_.size();
+      while (n_buckets <= static_cast<std::size_t>(key - cur_)) n_buckets *= 2;
+      grow_(n_buckets);
+    }
+    buckets_[key & mask_].push_back(v);
+    ++size_;
+  }
+
+  std::pair<Key, int> pop() {
+    assert(size_ > 0);
+    while (buckets_[cur_ & mask_].empty()) ++cur_;
+    std::vector<int> &bucket = buckets_[cur_ & mask_];
+    int v = bucket.back();
+    bucket.pop_back();
+    --size_;
+    return std::make_pair(cur_, v);
+  }
+
+  void clear() {
+    if (size_ > 0) {
+      for (auto &bucket : buckets_) bucket.clear();
+    }
+    size_ = 0;
+    cur_ = 0;
+  }
+
+private:
+  std::vector<std::vector<int>> buckets_;
+  std::size_t mask_ = 0;
+  int size_ = 0;
+  Key cur_ = 0;
+
+  // 各要素のキーはcur_ + ((添字 - cur_) & mask_)で復元できるので，バケットを並べ直す
+  void grow_(std::size_t n_buckets) {
+    std::vector<std::vector<int>> old;
+    old.swap(buckets_);
+    buckets_.resize(n_buckets);
+    std::size_t old_mask = mask_;
+    mask_ = n_buckets - 1;
+    for (std::size_t i = 0; i < old.size(); ++i) {
+      if (old[i].empty()) continue;
+      Key key = cur_ + static_cast<Key>((i - static_cast<std::size_t>(cur_)) & old_mask);
+      std::vector<int> &dst = buckets_[key & mask_];
+      dst.insert(dst.end(), old[i].begin(), old[i].end());
+    }
+  }
+};
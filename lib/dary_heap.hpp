@@ -0,0 +1,112 @@
+#pragma once
+/**
+ * @file dary_heap.hpp
+ * @brief 添字付きd分ヒープに関するコード。
+ * @details
+ * * 要素は0以上n未満の整数で，各要素はヒープ中に高々1つ存在する。
+ * * push: 要素が無ければ挿入し，あればキーを小さくする(decrease-key)。O(log_d n)
+ * * pop: キーが最小の要素を取り出す。O(d log_d n)
+ * * 二分ヒープより木が浅く，子が連続したメモリにあるのでキャッシュ効率が良い。
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 添字付きd分ヒープ(最小ヒープ)。
+ * @tparam Key キーの型。
+ * @tparam D 各節点の子の数。
+ */
+template <typename Key, int D = 4>
+class DaryHeap {
+public:
+  explicit DaryHeap(int n = 0) : pos_(n, -1) {}
+
+  /**
+   * @brief 扱う要素の範囲を[0, n)にする。ヒープは空になる。
+   */
+  void resize(int n) {
+    heap_.clear();
+    pos_.assign(n, -1);
+  }
+
+  bool empty() const { return heap_.empty(); }
+  int size() const { return heap_.size(); }
+  bool contains(int v) const { return pos_[v] != -1; }
+
+  /**
+   * @brief 要素vをキーkeyで挿入する。既に存在する場合は，keyの方が小さければキーを更新する。
+   */
+  void push(Key key, int v) {
+    int i = pos_[v];
+    if (i == -1) {
+      i = heap_.size();
+      heap_.emplace_back(key, v);
+    } else if (key < heap_[i].first) {
+      heap_[i].first = key;
+    } else {
+      return;
+    }
+    sift_up_(i, std::make_pair(key, v));
+  }
+
+  /**
+   * @brief キーが最小の要素を取り除き，(キー，要素)を返す。
+   */
+  std::pair<Key, int> pop() {
+    assert(!heap_.empty());
+    std::pair<Key, int> top = heap_[0];
+    pos_[top.second] = -1;
+    std::pair<Key, int> last = heap_.back();
+    heap_.pop_back();
+    if (!heap_.empty()) sift_down_(0, last);
+    return top;
+  }
+
+  /**
+   * @brief ヒープを空にする。O(ヒープ中の要素数)
+   */
+  void clear() {
+    for (const auto &kv : heap_) pos_[kv.second] = -1;
+    heap_.clear();
+  }
+
+private:
+  // (キー，要素)。キーを要素と並べて置き，比較のたびに別の配列を引かないようにする
+  std::vector<std::pair<Key, int>> heap_;
+  std::vector<int> pos_;
+
+  void place_(int i, const std::pair<Key, int> &kv) {
+    heap_[i] = kv;
+    pos_[kv.second] = i;
+  }
+
+  void sift_up_(int i, const std::pair<Key, int> &kv) {
+    while (i > 0) {
+      int parent = (i - 1) / D;
+      if (!(kv.first < heap_[parent].first)) break;
+      place_(i, heap_[parent]);
+      i = parent;
+    }
+    place_(i, kv);
+  }
+
+  void sift_down_(int i, const std::pair<Key, int> &kv) {
+    int n = heap_.size();
+    while (true) {
+      int first_child = i * D + 1;
+      if (first_child >= n) break;
+      int best = first_child;
+      int last_child = std::min(first_child + D, n);
+      for (int c = first_child + 1; c < last_child; ++c) {
+        if (heap_[c].first < heap_[best].first) best = c;
+      }
+      if (!(heap_[best].first < kv.first)) break;
+      place_(i, heap_[best]);
+      i = best;
+    }
+    place_(i, kv);
+  }
+};
@@ -22,6 +22,7 @@
  * @example fft_example.cpp
  */
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <vector>
@@ -40,26 +41,28 @@ public:
    *
    * @param f 多項式関数。
    * @param depth lg(fの項数)。
-   * @param root MOD 998244353での2冪乗根。
+   * @param root 法における2冪乗根。root[d]は1の2^d乗根。
    * @return fのDFT。
+   * @tparam Mint ModIntまたはDynamicModInt。
    */
-  static std::vector<mint> ntt(const std::vector<mint> &f,
+  template <class Mint>
+  static std::vector<Mint> ntt(const std::vector<Mint> &f,
                                int depth,
-                               const std::vector<mint> &root) {
+                               const std::vector<Mint> &root) {
     assert((int)std::pow(2, depth) == f.size());
     int sz = f.size();
     if (sz == 1) return f;
-    std::vector<mint> f0(sz / 2, 0), f1(sz / 2, 0);
+    std::vector<Mint> f0(sz / 2, 0), f1(sz / 2, 0);
     for (int i = 0; i < sz / 2; ++i) {
       f0[i] = f[i * 2];
       f1[i] = f[i * 2 + 1];
     }
-    std::vector<mint> ft_f0 = ntt(f0, depth - 1, root); // f0のDFT
-    std::vector<mint> ft_f1 = ntt(f1, depth - 1, root); // f1のDFT
-    mint zeta = root[depth];
-    mint pow_zeta = 1.0;
+    std::vector<Mint> ft_f0 = ntt(f0, depth - 1, root); // f0のDFT
+    std::vector<Mint> ft_f1 = ntt(f1, depth - 1, root); // f1のDFT
+    Mint zeta = root[depth];
+    Mint pow_zeta = 1;
 
-    std::vector<mint> ft_f(sz, 0); // fのDFT
+    std::vector<Mint> ft_f(sz, 0); // fのDFT
     for (int i = 0; i < sz; ++i) {
       ft_f[i] = ft_f0[i % (sz / 2)] + pow_zeta * ft_f1[i % (sz / 2)];
       pow_zeta *= zeta;
@@ -115,4 +118,49 @@ public:
 
     return res;
   }
+
+  /**
+   * @brief 任意のModInt型の多項式を畳み込む。
+   * @details 法Pは P - 1 が結果の長さ以上の2冪で割り切れる素数である必要がある。
+   *   DynamicModIntを使えば実行時に与えた法で畳み込める。
+   * @param f 1つ目の多項式。
+   * @param g 2つ目の多項式。
+   * @param primitive_root 法の原始根。
+   * @return 畳み込み結果の多項式。長さは f.size() + g.size() - 1。
+   */
+  template <class Mint>
+  static std::vector<Mint> convolve(const std::vector<Mint> &f,
+                                    const std::vector<Mint> &g,
+                                    long long primitive_root = PRIMITIVE_ROOT) {
+    if (f.empty() || g.empty()) return std::vector<Mint>();
+    int sz = 1;
+    int log_sz = 0;
+    while (sz < (int)(f.size() + g.size() - 1)) {
+      sz *= 2;
+      ++log_sz;
+    }
+    long long mod = Mint::get_mod();
+    assert((mod - 1) % sz == 0);
+
+    std::vector<Mint> root(log_sz + 1, 0), inv_root(log_sz + 1, 0);
+    root[log_sz] = Mint(primitive_root).pow((mod - 1) / sz);
+    inv_root[log_sz] = root[log_sz].inv();
+    for (int i = log_sz - 1; i >= 0; --i) {
+      root[i] = root[i + 1] * root[i + 1];
+      inv_root[i] = inv_root[i + 1] * inv_root[i + 1];
+    }
+
+    std::vector<Mint> ext_f(sz, 0), ext_g(sz, 0);
+    std::copy(f.begin(), f.end(), ext_f.begin());
+    std::copy(g.begin(), g.end(), ext_g.begin());
+    std::vector<Mint> ft_fg = ntt(ext_f, log_sz, root);
+    std::vector<Mint> ft_g = ntt(ext_g, log_sz, root);
+    for (int i = 0; i < sz; ++i) ft_fg[i] *= ft_g[i];
+
+    std::vector<Mint> fg = ntt(ft_fg, log_sz, inv_root);
+    Mint inv_sz = Mint(sz).inv();
+    fg.resize(f.size() + g.size() - 1);
+    for (Mint &c : fg) c *= inv_sz;
+    return fg;
+  }
 }; // class FFT
\ No newline at end of file
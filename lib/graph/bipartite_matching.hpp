@@ -0,0 +1,201 @@
+#pragma once
+/**
+ * @file bipartite_matching.hpp
+ * @brief 二部グラフの最大マッチング
+ * @details
+ * * HopcroftKarp
+ *   * 左側の頂点から右側の頂点への辺をCSR形式(CSRGraph<>)で受け取り，\f$O(M \sqrt N)\f$で最大マッチングを求める．
+ *   * 最初に貪欲法(辺の少ない右頂点を優先する)でマッチングを作ってから，増加路を探す．
+ *   * 各フェーズでは，未マッチの左頂点からのBFSで層を作り，層に沿ったDFSで互いに素な最短増加路をまとめて見つける．
+ *     DFSは再帰を使わず，各頂点で次に調べる辺の位置を覚えておく．
+ *   * 最大マッチングから，Kőnigの定理により最小頂点被覆を求める．
+ *   * 最小頂点被覆もコンストラクタで求めるので，グラフは保持しない．
+ */
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+
+class HopcroftKarp {
+public:
+  /**
+   * @brief HopcroftKarpクラスのコンストラクタ．最大マッチングと最小頂点被覆を求める．\f$O(M \sqrt N)\f$
+   *
+   * @param g 左側の頂点0, ..., g.size() - 1から右側の頂点0, ..., n_right - 1への辺を持つグラフ．
+   *   コンストラクタの中でのみ使う．
+   * @param n_right 右側の頂点数．
+   */
+  HopcroftKarp(const CSRGraph<> &g, int n_right)
+    : n_left_(g.size()), n_right_(n_right),
+      match_left_(n_left_, -1), match_right_(n_right_, -1), dist_(n_left_), iter_(n_left_)
+  {
+    greedy_(g);
+    while (bfs_(g)) {
+      std::fill(iter_.begin(), iter_.end(), 0);
+      for (int u = 0; u < n_left_; ++u) {
+        if (match_left_[u] == -1 && augment_(g, u)) ++size_;
+      }
+    }
+    vertex_cover_(g);
+    std::vector<int>().swap(dist_);
+    std::vector<int>().swap(iter_);
+    std::vector<int>().swap(queue_);
+    std::vector<int>().swap(stack_);
+  }
+
+  /**
+   * @brief 最大マッチングの辺数
+   */
+  int size() const { return size_; }
+
+  /**
+   * @brief 左頂点uとマッチした右頂点．なければ-1
+   */
+  int match_left(int u) const { return match_left_[u]; }
+
+  /**
+   * @brief 右頂点vとマッチした左頂点．なければ-1
+   */
+  int match_right(int v) const { return match_right_[v]; }
+
+  /**
+   * @brief 最大マッチングを(左頂点，右頂点)の配列で返す．
+   */
+  std::vector<std::pair<int, int>> matching() const {
+    std::vector<std::pair<int, int>> ret;
+    ret.reserve(size_);
+    for (int u = 0; u < n_left_; ++u) {
+      if (match_left_[u] != -1) ret.emplace_back(u, match_left_[u]);
+    }
+    return ret;
+  }
+
+  /**
+   * @brief 最小頂点被覆を(左頂点の配列，右頂点の配列)で返す．大きさはsize()に等しい．
+   * @details 未マッチの左頂点から交互路で到達できる頂点の集合をZとして，(左 \ Z) ∪ (右 ∩ Z)．
+   */
+  const std::pair<std::vector<int>, std::vector<int>> &min_vertex_cover() const { return cover_; }
+
+private:
+  int n_left_, n_right_;
+  int size_ = 0;
+  std::vector<int> match_left_, match_right_;
+  std::pair<std::vector<int>, std::vector<int>> cover_;
+  // dist_[u]は未マッチの左頂点から左頂点uまでの交互路の長さ / 2．到達できなければ-1
+  std::vector<int> dist_;
+  // iter_[u]は左頂点uの隣接リストで次に調べる位置
+  std::vector<int> iter_;
+  std::vector<int> queue_;
+  // DFSでの左頂点の列
+  std::vector<int> stack_;
+
+  // 次数が小さい右頂点を優先して，貪欲にマッチさせる
+  void greedy_(const CSRGraph<> &g) {
+    std::vector<int> degree(n_right_, 0);
+    for (int u = 0; u < n_left_; ++u) {
+      for (int v : g.adj(u)) ++degree[v];
+    }
+    for (int u = 0; u < n_left_; ++u) {
+      int best = -1;
+      for (int v : g.adj(u)) {
+        --degree[v];
+        if (match_right_[v] == -1 && (best == -1 || degree[v] < degree[best])) best = v;
+      }
+      if (best == -1) continue;
+      match_left_[u] = best;
+      match_right_[best] = u;
+      ++size_;
+    }
+  }
+
+  // 層を作る．最短増加路があればtrue
+  bool bfs_(const CSRGraph<> &g) {
+    queue_.clear();
+    for (int u = 0; u < n_left_; ++u) {
+      dist_[u] = match_left_[u] == -1 ? 0 : -1;
+      if (dist_[u] == 0) queue_.push_back(u);
+    }
+    bool found = false;
+    for (std::size_t head = 0; head < queue_.size(); ++head) {
+      int u = queue_[head];
+      for (int v : g.adj(u)) {
+        int w = match_right_[v];
+        if (w == -1) {
+          found = true;
+        } else if (dist_[w] == -1) {
+          dist_[w] = dist_[u] + 1;
+          // 最短増加路より長い層は不要
+          if (!found) queue_.push_back(w);
+        }
+      }
+    }
+    return found;
+  }
+
+  // 左頂点rootから層に沿って増加路を探し，見つかれば反転する
+  bool augment_(const CSRGraph<> &g, int root) {
+    stack_.assign(1, root);
+    while (!stack_.empty()) {
+      const int u = stack_.back();
+      const CSRRange<int> adj = g.adj(u);
+      int next = -1;
+      for (int &i = iter_[u]; i < adj.size(); ++i) {
+        const int w = match_right_[adj[i]];
+        if (w == -1) {
+          // stack_の各頂点を，iter_が指す右頂点とマッチさせる
+          for (int x : stack_) {
+            const int y = g.adj(x)[iter_[x]];
+            match_left_[x] = y;
+            match_right_[y] = x;
+            dist_[x] = -1;
+          }
+          return true;
+        }
+        if (dist_[w] == dist_[u] + 1) {
+          next = w;
+          break;
+        }
+      }
+      if (next != -1) {
+        stack_.push_back(next);
+      } else {
+        // uからは増加路がない
+        dist_[u] = -1;
+        stack_.pop_back();
+        if (!stack_.empty()) ++iter_[stack_.back()];
+      }
+    }
+    return false;
+  }
+
+  // Kőnigの定理により，最大マッチングから最小頂点被覆を求める．O(N + M)
+  void vertex_cover_(const CSRGraph<> &g) {
+    std::vector<char> left_seen(n_left_, false), right_seen(n_right_, false);
+    queue_.clear();
+    for (int u = 0; u < n_left_; ++u) {
+      if (match_left_[u] == -1) {
+        left_seen[u] = true;
+        queue_.push_back(u);
+      }
+    }
+    for (std::size_t head = 0; head < queue_.size(); ++head) {
+      for (int v : g.adj(queue_[head])) {
+        if (right_seen[v]) continue;
+        right_seen[v] = true;
+        int w = match_right_[v];
+        if (w != -1 && !left_seen[w]) {
+          left_seen[w] = true;
+          queue_.push_back(w);
+        }
+      }
+    }
+    for (int u = 0; u < n_left_; ++u) {
+      if (!left_seen[u]) cover_.first.push_back(u);
+    }
+    for (int v = 0; v < n_right_; ++v) {
+      if (right_seen[v]) cover_.second.push_back(v);
+    }
+  }
+};
@@ -0,0 +1,191 @@
+#pragma once
+/**
+ * @file boruvka.hpp
+ * @brief 並列Borůvka法による最小全域森
+ * @details
+ * * 各ラウンドで，全ての連結成分についてそこから出る最小の辺を並列に求め，それらを一斉に採用する．
+ *   * 成分毎の最小の辺はatomicな辺の位置として持ち，(重み，位置)の辞書順で比較する．
+ *     重みが等しい辺があっても閉路はできない．
+ *   * 成分数はラウンド毎に半分以下になるので，ラウンド数はO(log N)．
+ * * 作業用の辺の配列は端点を成分の代表として持ち，ラウンド毎に代表を付け替える．
+ *   両端が同じ成分になった辺はこのときに取り除き，以降のラウンドで走査する辺を減らす．
+ * * インターフェースはKruskalと同じ．
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "union_find.hpp"
+
+template <typename CostType>
+class Boruvka {
+  using Edge = std::tuple<int, int, CostType>;
+
+public:
+  /**
+   * @brief Boruvkaクラスのコンストラクタ
+   *
+   * @param n 頂点数
+   * @param n_threads 使うスレッド数
+   */
+  explicit Boruvka(int n, int n_threads = 1) : n_(n), n_threads_(std::max(n_threads, 1)) {}
+
+  void add_edge(const int u, const int v, const CostType c) {
+    edges_.push_back(FlatEdge{c, u, v});
+  }
+
+  /**
+   * @brief 追加された全ての辺に対する最小全域森を求める．O((M / スレッド数 + N) log N)
+   */
+  void solve() {
+    std::vector<int> active(n_), label(n_);
+    for (int v = 0; v < n_; ++v) active[v] = v;
+    std::unique_ptr<Slot[]> best(new Slot[n_]);
+    for (int v = 0; v < n_; ++v) {
+      best[v].index.store(-1, std::memory_order_relaxed);
+      best[v].cost.store(std::numeric_limits<CostType>::max(), std::memory_order_relaxed);
+    }
+
+    // 生きている辺．端点は成分の代表で持ち，両端が同じ成分になった辺は取り除く
+    std::vector<WorkEdge> work(edges_.size());
+    for (std::size_t i = 0; i < edges_.size(); ++i) {
+      work[i] = WorkEdge{edges_[i].cost, edges_[i].u, edges_[i].v, static_cast<int>(i)};
+    }
+    UnionFind uf(n_);
+    msf_.clear();
+
+    while (!work.empty()) {
+      // 各成分から出る最小の辺を求める．同じ重みの辺はworkでの位置で比べる
+      parallel_for_(work.size(), [&](int, std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+          if (work[i].cu == work[i].cv) continue;
+          update_min_(work, best[work[i].cu], i);
+          update_min_(work, best[work[i].cv], i);
+        }
+      });
+
+      // 最小の辺を採用する．成分の数はラウンド毎に半分以下になる
+      bool merged = false;
+      for (int c : active) {
+        int i = best[c].index.exchange(-1, std::memory_order_relaxed);
+        best[c].cost.store(std::numeric_limits<CostType>::max(), std::memory_order_relaxed);
+        if (i == -1) continue;
+        if (uf.unite(work[i].cu, work[i].cv)) {
+          const FlatEdge &e = edges_[work[i].id];
+          msf_.emplace_back(e.u, e.v, e.cost);
+          merged = true;
+        }
+      }
+      if (!merged) break;
+
+      // 成分の代表をUnionFindの根に付け替える
+      std::size_t n_active = 0;
+      for (int c : active) {
+        label[c] = uf.root(c);
+        if (label[c] == c) active[n_active++] = c;
+      }
+      active.resize(n_active);
+      relabel_(work, label);
+    }
+    is_solved_ = true;
+  }
+
+  bool is_mst() const {
+    assert(is_solved_);
+    return msf_.size() + 1 == static_cast<std::size_t>(n_);
+  }
+
+  CostType get_cost_sum() const {
+    assert(is_solved_);
+    CostType ret = 0;
+    for (auto [u, v, c] : msf_) ret += c;
+    return ret;
+  }
+
+  std::vector<Edge> get_msf() const {
+    assert(is_solved_);
+    return msf_;
+  }
+
+private:
+  struct FlatEdge {
+    CostType cost;
+    int u, v;
+  };
+
+  int n_;
+  int n_threads_;
+  bool is_solved_ = false;
+  std::vector<FlatEdge> edges_;
+  std::vector<Edge> msf_;
+
+  struct WorkEdge {
+    CostType cost;
+    int cu, cv;
+    int id;
+  };
+
+  // 成分から出る最小の辺
+  struct Slot {
+    // 最小の辺のworkでの位置．-1なら未定
+    std::atomic<int> index;
+    // ある時点での最小の辺の重み(未定ならCostTypeの最大値)．
+    // 真の最小以上なので，これより重い辺は比較せずに捨てられる
+    std::atomic<CostType> cost;
+  };
+
+  // slotの辺を，(重み，位置)の辞書順でwork[i]の方が小さければwork[i]に置き換える
+  static void update_min_(const std::vector<WorkEdge> &work, Slot &slot, int i) {
+    const CostType cost = work[i].cost;
+    int cur = slot.index.load(std::memory_order_relaxed);
+    if (slot.cost.load(std::memory_order_relaxed) < cost) return;
+    while (cur == -1 || cost < work[cur].cost || (!(work[cur].cost < cost) && i < cur)) {
+      if (slot.index.compare_exchange_weak(cur, i, std::memory_order_relaxed)) {
+        slot.cost.store(cost, std::memory_order_relaxed);
+        return;
+      }
+    }
+  }
+
+  // [0, count)をn_threads_個の区間に分け，fn(スレッド番号，区間の始め，区間の終わり)を並列に呼ぶ
+  void parallel_for_(std::size_t count, const std::function<void(int, std::size_t, std::size_t)> &fn) const {
+    int n_threads = std::max(1, std::min<int>(n_threads_, count / 4096 + 1));
+    std::vector<std::thread> threads;
+    for (int t = 1; t < n_threads; ++t) {
+      threads.emplace_back(fn, t, count * t / n_threads, count * (t + 1) / n_threads);
+    }
+    fn(0, 0, count / n_threads);
+    for (std::thread &th : threads) th.join();
+  }
+
+  // 辺の端点を新しい成分の代表に付け替え，両端が同じ成分になった辺を取り除く．辺の順序は保つ
+  void relabel_(std::vector<WorkEdge> &work, const std::vector<int> &label) const {
+    int n_threads = std::max(1, std::min<int>(n_threads_, work.size() / 4096 + 1));
+    std::vector<std::size_t> kept(n_threads);
+    parallel_for_(work.size(), [&](int t, std::size_t first, std::size_t last) {
+      std::size_t k = first;
+      for (std::size_t i = first; i < last; ++i) {
+        WorkEdge w = work[i];
+        w.cu = label[w.cu];
+        w.cv = label[w.cv];
+        if (w.cu != w.cv) work[k++] = w;
+      }
+      kept[t] = k - first;
+    });
+    // 各スレッドが詰めた区間を前に寄せる
+    std::size_t size = kept[0];
+    for (int t = 1; t < n_threads; ++t) {
+      std::size_t first = work.size() * t / n_threads;
+      std::copy(work.begin() + first, work.begin() + first + kept[t], work.begin() + size);
+      size += kept[t];
+    }
+    work.resize(size);
+  }
+};
@@ -0,0 +1,591 @@
+#pragma once
+/**
+ * @file contraction_hierarchies.hpp
+ * @brief Contraction Hierarchiesに関するコード
+ * @details
+ * * 静的なグラフに対する2点間最短路クエリを前処理で高速化する．
+ * * 前処理
+ *   * 頂点を優先度(追加する近道の数 - 削除される辺の数 + 縮約済みの隣接頂点数 + 階層の深さ)の小さい順に縮約する．
+ *   * 頂点vの縮約では，u -> v -> xがu, x間の最短路であるとき(ウィットネス探索で迂回路が見つからないとき)に近道u -> xを追加する．
+ *   * 縮約は回に分けて行う．各回では，2近傍(隣接頂点とその隣接頂点)の中で優先度が最小の頂点を全て縮約する．
+ *     これらは互いに隣接せず隣接頂点も共有しないので，ウィットネス探索も近道の追加も複数スレッドで並列に行える．
+ *     ウィットネス探索は同じ回に縮約する頂点を通らない．
+ *   * 優先度の見積もり(縮約のシミュレーション)は初めに全頂点について並列に行う．縮約した頂点の隣接頂点は
+ *     縮約済みの隣接頂点数と深さだけ更新し，縮約の候補に選ばれた時に並列に見積もり直す．
+ *   * 縮約の順を順位とし，順位が上がる向きの辺だけを残す．
+ * * クエリ
+ *   * 始点から上向きの辺のみ，終点から(逆向きに)上向きの辺のみを辿る双方向Dijkstra法．
+ *   * 近道を展開すれば元のグラフでの経路が得られる．
+ * * save / loadで前処理の結果を平坦な配列のままバイナリで読み書きする．
+ * @example contraction_hierarchies_test.cpp
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <numeric>
+#include <ostream>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "../dary_heap.hpp"
+
+/**
+ * @brief Contraction Hierarchiesによる2点間最短路のクラス
+ * @tparam CostType 辺の重みの型．算術型である必要がある．
+ */
+template <typename CostType>
+class ContractionHierarchies {
+public:
+  /**
+   * @brief 近道を含む上向きの辺．middleは近道が経由する頂点で，元の辺なら-1．
+   */
+  struct Arc {
+    int to;
+    CostType cost;
+    int middle;
+  };
+
+  /**
+   * @brief 前処理を行う．
+   *
+   * @param g グラフ．
+   * @param n_threads 優先度の見積もりと縮約に使うスレッド数．
+   * @param witness_settle_limit ウィットネス探索で確定させる頂点数の上限．小さいほど前処理は速いが近道が増える．
+   */
+  explicit ContractionHierarchies(const CSRGraph<CostType> &g, int n_threads = 1, int witness_settle_limit = 500)
+    : n_(g.size()), witness_settle_limit_(witness_settle_limit)
+  {
+    preprocess_(g, std::max(n_threads, 1));
+    init_query_workspace_();
+  }
+
+  /**
+   * @brief saveで書き出した前処理の結果を読み込む．
+   * @details 形式やCostTypeが異なる，または読み込んだ配列が前処理の結果として正しくなければ，
+   *   isにfailbitを立てて頂点数0の結果を返す．
+   */
+  static ContractionHierarchies load(std::istream &is) {
+    ContractionHierarchies ch;
+    std::uint64_t header[HEADER_SIZE_];
+    is.read(reinterpret_cast<char *>(header), sizeof(header));
+    if (!is || !std::equal(header, header + HEADER_SIZE_, header_().begin())) {
+      is.setstate(std::ios::failbit);
+      return ch;
+    }
+    read_vector_(is, ch.rank_);
+    read_vector_(is, ch.up_start_);
+    read_vector_(is, ch.up_);
+    read_vector_(is, ch.down_start_);
+    read_vector_(is, ch.down_);
+    ch.n_ = ch.rank_.size();
+    if (!is || !ch.is_valid_()) {
+      is.setstate(std::ios::failbit);
+      return ContractionHierarchies();
+    }
+    ch.init_query_workspace_();
+    return ch;
+  }
+
+  /**
+   * @brief 前処理の結果をバイナリで書き出す．
+   */
+  void save(std::ostream &os) const {
+    const std::array<std::uint64_t, HEADER_SIZE_> header = header_();
+    os.write(reinterpret_cast<const char *>(header.data()), sizeof(header));
+    write_vector_(os, rank_);
+    write_vector_(os, up_start_);
+    write_vector_(os, up_);
+    write_vector_(os, down_start_);
+    write_vector_(os, down_);
+  }
+
+  int size() const { return n_; }
+
+  /**
+   * @brief 頂点vの縮約順(順位)
+   */
+  int rank(int v) const { return rank_[v]; }
+
+  /**
+   * @brief 近道を含む上向きの辺の総数
+   */
+  int arc_count() const { return up_.size() + down_.size(); }
+
+  /**
+   * @brief sからtへの最短距離を返す．到達不可能ならCostTypeの最大値．
+   */
+  CostType query(int s, int t) {
+    run_query_(s, t);
+    return best_;
+  }
+
+  /**
+   * @brief sからtへの最短路を，元のグラフの頂点列で返す．到達不可能なら空．
+   */
+  std::vector<int> path(int s, int t) {
+    run_query_(s, t);
+    std::vector<int> ret;
+    if (meet_ == -1) return ret;
+
+    std::vector<std::pair<int, int>> up_arcs; // (頂点，その頂点から出る上向きの辺の番号)
+    for (int v = meet_; v != s; v = side_[0].prev_v[v]) up_arcs.emplace_back(side_[0].prev_v[v], side_[0].prev_arc[v]);
+    std::reverse(up_arcs.begin(), up_arcs.end());
+    ret.push_back(s);
+    for (auto [u, arc_id] : up_arcs) unpack_(u, up_[arc_id], true, ret);
+    for (int v = meet_; v != t; v = side_[1].prev_v[v]) unpack_(side_[1].prev_v[v], down_[side_[1].prev_arc[v]], false, ret);
+    return ret;
+  }
+
+  /**
+   * @brief 直前のクエリで確定させた頂点数
+   */
+  int settled_count() const { return settled_count_; }
+
+private:
+  static constexpr CostType INF_ = std::numeric_limits<CostType>::max();
+  static constexpr std::uint64_t MAGIC_ = 0x314843414e494b4fULL;
+  static constexpr int HEADER_SIZE_ = 4;
+  static constexpr std::size_t READ_CHUNK_ = 1 << 16;
+  static constexpr int SIMULATION_SETTLE_LIMIT_ = 50;
+  static constexpr int PARALLEL_GRAIN_ = 1024;
+
+  struct Workspace {
+    std::vector<CostType> dist;
+    std::vector<unsigned> stamp, target;
+    unsigned epoch = 0;
+    DaryHeap<CostType> heap;
+    // クエリ用．直前の頂点と，その頂点から辿った辺の番号
+    std::vector<int> prev_v, prev_arc;
+
+    void init(int n, bool with_prev) {
+      dist.assign(n, 0);
+      stamp.assign(n, 0);
+      target.assign(n, 0);
+      epoch = 0;
+      heap.resize(n);
+      if (with_prev) {
+        prev_v.assign(n, -1);
+        prev_arc.assign(n, -1);
+      }
+    }
+
+    void next_epoch() {
+      heap.clear();
+      if (++epoch == 0) {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        std::fill(target.begin(), target.end(), 0);
+        epoch = 1;
+      }
+    }
+
+    bool reached(int v) const { return stamp[v] == epoch; }
+
+    CostType get(int v) const { return reached(v) ? dist[v] : INF_; }
+
+    void set(int v, CostType d) {
+      stamp[v] = epoch;
+      dist[v] = d;
+    }
+  };
+
+  int n_ = 0;
+  int witness_settle_limit_ = 500;
+  std::vector<int> rank_;
+  // up_: 頂点uから順位の高い頂点への辺．down_: 順位の高い頂点uからの辺u -> vを，vにおける(u)として保持
+  std::vector<int> up_start_, down_start_;
+  std::vector<Arc> up_, down_;
+
+  Workspace side_[2];
+  CostType best_ = INF_;
+  int meet_ = -1;
+  int settled_count_ = 0;
+
+  ContractionHierarchies() {}
+
+  // 形式の識別子，辺の大きさ，CostTypeの大きさと浮動小数点数かどうか
+  static std::array<std::uint64_t, HEADER_SIZE_> header_() {
+    return {MAGIC_, sizeof(Arc), sizeof(CostType), std::is_floating_point<CostType>::value};
+  }
+
+  template <typename T>
+  static void write_vector_(std::ostream &os, const std::vector<T> &v) {
+    std::uint64_t len = v.size();
+    os.write(reinterpret_cast<const char *>(&len), sizeof(len));
+    os.write(reinterpret_cast<const char *>(v.data()), sizeof(T) * len);
+  }
+
+  // 長さが壊れていても実際に読めたデータの分しか確保しないように，READ_CHUNK_個ずつ読む
+  template <typename T>
+  static void read_vector_(std::istream &is, std::vector<T> &v) {
+    std::uint64_t len = 0;
+    is.read(reinterpret_cast<char *>(&len), sizeof(len));
+    if (!is) return;
+    if (len > std::uint64_t(std::numeric_limits<int>::max())) {
+      is.setstate(std::ios::failbit);
+      return;
+    }
+    v.clear();
+    while (v.size() < len && is) {
+      const std::size_t old_size = v.size();
+      v.resize(std::min<std::size_t>(len, old_size + READ_CHUNK_));
+      is.read(reinterpret_cast<char *>(v.data() + old_size), sizeof(T) * (v.size() - old_size));
+    }
+  }
+
+  // 読み込んだ配列を検査する．順位は順列で，辺は順位の高い頂点へ向かい，近道の経由頂点は両端より順位が低く，
+  // 経由頂点には近道を展開するための2本の辺がある
+  bool is_valid_() const {
+    if (up_start_.size() != std::size_t(n_) + 1 || down_start_.size() != std::size_t(n_) + 1) return false;
+    std::vector<char> seen(n_, 0);
+    for (int r : rank_) {
+      if (r < 0 || r >= n_ || seen[r]) return false;
+      seen[r] = 1;
+    }
+    for (int d = 0; d < 2; ++d) {
+      const std::vector<int> &start = d == 0 ? up_start_ : down_start_;
+      const std::vector<Arc> &arcs = d == 0 ? up_ : down_;
+      if (start[0] != 0 || std::size_t(start[n_]) != arcs.size()) return false;
+      for (int v = 0; v < n_; ++v) {
+        if (start[v] > start[v + 1]) return false;
+      }
+    }
+    for (int d = 0; d < 2; ++d) {
+      const std::vector<int> &start = d == 0 ? up_start_ : down_start_;
+      const std::vector<Arc> &arcs = d == 0 ? up_ : down_;
+      for (int v = 0; v < n_; ++v) {
+        for (int id = start[v]; id < start[v + 1]; ++id) {
+          const Arc &a = arcs[id];
+          if (a.to < 0 || a.to >= n_ || rank_[a.to] <= rank_[v]) return false;
+          if (a.middle == -1) continue;
+          if (a.middle < -1 || a.middle >= n_ || rank_[a.middle] >= rank_[v]) return false;
+          // 近道u -> wの展開にはmにおけるdown_の(u)とup_の(w)が要る
+          const int m = a.middle, u = d == 0 ? v : a.to, w = d == 0 ? a.to : v;
+          if (!has_arc_(down_start_, down_, m, u) || !has_arc_(up_start_, up_, m, w)) return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  static bool has_arc_(const std::vector<int> &start, const std::vector<Arc> &arcs, int v, int to) {
+    for (int id = start[v]; id < start[v + 1]; ++id) {
+      if (arcs[id].to == to) return true;
+    }
+    return false;
+  }
+
+  void init_query_workspace_() {
+    side_[0].init(n_, true);
+    side_[1].init(n_, true);
+  }
+
+  // 縮約中のグラフ．in_[v]の要素(u, c)は辺u -> vを表す
+  struct Dynamic {
+    std::vector<std::vector<Arc>> out, in;
+    std::vector<char> contracted;
+    // 縮約済みの隣接頂点数と，縮約済みの隣接頂点の階層の深さ+1の最大値
+    std::vector<int> deleted_neighbors, level;
+  };
+
+  struct Shortcut {
+    int from, to;
+    CostType cost;
+  };
+
+  static void add_or_improve_(std::vector<Arc> &arcs, int to, CostType cost, int middle) {
+    for (Arc &a : arcs) {
+      if (a.to == to) {
+        if (cost < a.cost) a.cost = cost, a.middle = middle;
+        return;
+      }
+    }
+    arcs.push_back(Arc{to, cost, middle});
+  }
+
+  // vを縮約する際に必要な近道を求める
+  void find_shortcuts_(const Dynamic &dg, int v, int settle_limit, Workspace &ws, std::vector<Shortcut> &shortcuts) const {
+    shortcuts.clear();
+    for (const Arc &in_arc : dg.in[v]) {
+      int u = in_arc.to;
+      CostType max_cost = 0;
+      bool has_target = false;
+      for (const Arc &out_arc : dg.out[v]) {
+        if (out_arc.to == u) continue;
+        has_target = true;
+        max_cost = std::max(max_cost, in_arc.cost + out_arc.cost);
+      }
+      if (!has_target) continue;
+
+      // vと同じ回に縮約する頂点を通らない，長さmax_cost以下のuからの経路を探す．全ての行き先が確定すれば打ち切る
+      ws.next_epoch();
+      int remaining = 0;
+      for (const Arc &out_arc : dg.out[v]) {
+        if (out_arc.to != u && ws.target[out_arc.to] != ws.epoch) {
+          ws.target[out_arc.to] = ws.epoch;
+          ++remaining;
+        }
+      }
+      ws.set(u, 0);
+      ws.heap.push(0, u);
+      int settled = 0;
+      while (!ws.heap.empty() && settled < settle_limit && remaining > 0) {
+        auto [dw, w] = ws.heap.pop();
+        if (dw > max_cost) break;
+        ++settled;
+        if (ws.target[w] == ws.epoch) --remaining;
+        for (const Arc &a : dg.out[w]) {
+          if (a.to == v || dg.contracted[a.to]) continue;
+          CostType nd = dw + a.cost;
+          if (nd < ws.get(a.to)) {
+            ws.set(a.to, nd);
+            ws.heap.push(nd, a.to);
+          }
+        }
+      }
+
+      for (const Arc &out_arc : dg.out[v]) {
+        if (out_arc.to == u) continue;
+        CostType via = in_arc.cost + out_arc.cost;
+        if (ws.get(out_arc.to) > via) shortcuts.push_back(Shortcut{u, out_arc.to, via});
+      }
+    }
+  }
+
+  // 優先度の見積もりでは探索を小さく打ち切る(近道の数を多めに見積もるだけで，正しさには影響しない)
+  int priority_(const Dynamic &dg, int v, Workspace &ws, std::vector<Shortcut> &shortcuts) const {
+    find_shortcuts_(dg, v, std::min(witness_settle_limit_, SIMULATION_SETTLE_LIMIT_), ws, shortcuts);
+    return int(shortcuts.size()) - int(dg.in[v].size()) - int(dg.out[v].size())
+           + dg.deleted_neighbors[v] + dg.level[v];
+  }
+
+  // 1スレッドあたりgrain個以上の仕事がある分だけスレッドを立てる
+  static void parallel_for_(int n_threads, int count, int grain, const std::function<void(int, int)> &fn) {
+    n_threads = std::min(n_threads, (count + grain - 1) / grain);
+    std::atomic<int> next(0);
+    auto worker = [&](int thread_id) {
+      for (int i; (i = next.fetch_add(1)) < count;) fn(thread_id, i);
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < n_threads; ++t) threads.emplace_back(worker, t);
+    worker(0);
+    for (std::thread &th : threads) th.join();
+  }
+
+  // vを縮約し，近道を追加する．vの上向きの辺をup，下向きの辺をdownに移す
+  static void contract_(Dynamic &dg, int v, const std::vector<Shortcut> &shortcuts, std::vector<Arc> &up,
+                        std::vector<Arc> &down, std::vector<int> &priority, std::vector<char> &stale) {
+    up = dg.out[v];
+    down = dg.in[v];
+    for (const Shortcut &sc : shortcuts) {
+      add_or_improve_(dg.out[sc.from], sc.to, sc.cost, v);
+      add_or_improve_(dg.in[sc.to], sc.from, sc.cost, v);
+    }
+
+    std::vector<int> neighbors;
+    for (const Arc &a : dg.in[v]) {
+      auto &arcs = dg.out[a.to];
+      arcs.erase(std::remove_if(arcs.begin(), arcs.end(), [v](const Arc &b) { return b.to == v; }), arcs.end());
+      neighbors.push_back(a.to);
+    }
+    for (const Arc &a : dg.out[v]) {
+      auto &arcs = dg.in[a.to];
+      arcs.erase(std::remove_if(arcs.begin(), arcs.end(), [v](const Arc &b) { return b.to == v; }), arcs.end());
+      neighbors.push_back(a.to);
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+    std::vector<Arc>().swap(dg.out[v]);
+    std::vector<Arc>().swap(dg.in[v]);
+    // 隣接頂点の優先度は縮約済みの隣接頂点数と深さの増分だけ更新し，近道の数は縮約の候補になった時に見積もり直す
+    for (int w : neighbors) {
+      int new_level = std::max(dg.level[w], dg.level[v] + 1);
+      priority[w] += 1 + new_level - dg.level[w];
+      ++dg.deleted_neighbors[w];
+      dg.level[w] = new_level;
+      stale[w] = 1;
+    }
+  }
+
+  void preprocess_(const CSRGraph<CostType> &g, int n_threads) {
+    Dynamic dg;
+    dg.out.resize(n_);
+    dg.in.resize(n_);
+    dg.contracted.assign(n_, 0);
+    dg.deleted_neighbors.assign(n_, 0);
+    dg.level.assign(n_, 0);
+    for (int u = 0; u < n_; ++u) {
+      for (const auto &e : g.adj(u)) {
+        if (e.to == u) continue;
+        add_or_improve_(dg.out[u], e.to, e.cost, -1);
+      }
+    }
+    for (int u = 0; u < n_; ++u) {
+      for (const Arc &a : dg.out[u]) dg.in[a.to].push_back(Arc{u, a.cost, a.middle});
+    }
+
+    std::vector<Workspace> workspaces(n_threads);
+    for (Workspace &ws : workspaces) ws.init(n_, false);
+    std::vector<std::vector<Shortcut>> buffers(n_threads);
+    std::vector<int> priority(n_);
+    parallel_for_(n_threads, n_, 1, [&](int thread_id, int v) {
+      priority[v] = priority_(dg, v, workspaces[thread_id], buffers[thread_id]);
+    });
+
+    // 優先度は(priority, 頂点番号)の辞書順で比べる
+    using Key = std::pair<int, int>;
+    std::vector<int> remaining(n_), selected;
+    std::iota(remaining.begin(), remaining.end(), 0);
+    std::vector<Key> nearest(n_);
+    std::vector<char> stale(n_, 0), is_selected(n_, 0);
+    std::vector<std::vector<Shortcut>> shortcuts;
+    rank_.assign(n_, -1);
+    std::vector<std::vector<Arc>> up(n_), down(n_);
+    int next_rank = 0;
+    while (!remaining.empty()) {
+      // 2近傍の最小値を選ぶ．nearest[v]は1近傍の最小値で，vが2近傍の最小値なら
+      // vと全ての隣接頂点wについてnearest[w] == (priority[v], v)
+      const int m = remaining.size();
+      parallel_for_(n_threads, m, PARALLEL_GRAIN_, [&](int, int i) {
+        const int v = remaining[i];
+        Key k(priority[v], v);
+        for (const Arc &a : dg.in[v]) k = std::min(k, Key(priority[a.to], a.to));
+        for (const Arc &a : dg.out[v]) k = std::min(k, Key(priority[a.to], a.to));
+        nearest[v] = k;
+      });
+      parallel_for_(n_threads, m, PARALLEL_GRAIN_, [&](int, int i) {
+        const int v = remaining[i];
+        const Key k(priority[v], v);
+        bool ok = nearest[v] == k;
+        for (const Arc &a : dg.in[v]) ok = ok && nearest[a.to] == k;
+        for (const Arc &a : dg.out[v]) ok = ok && nearest[a.to] == k;
+        is_selected[v] = ok;
+      });
+      selected.clear();
+      for (int v : remaining) {
+        if (is_selected[v]) selected.push_back(v);
+      }
+
+      // 見積もりが古い候補は優先度を求め直し，上がっていればこの回には縮約しない．
+      // 候補同士は2近傍に含まれないので，残った候補は2近傍の最小値のまま
+      parallel_for_(n_threads, selected.size(), 1, [&](int thread_id, int i) {
+        const int v = selected[i];
+        if (!stale[v]) return;
+        const int p = priority_(dg, v, workspaces[thread_id], buffers[thread_id]);
+        if (p > priority[v]) is_selected[v] = 0;
+        priority[v] = p;
+        stale[v] = 0;
+      });
+      selected.clear();
+      int kept = 0;
+      for (int v : remaining) {
+        if (is_selected[v]) {
+          selected.push_back(v);
+          rank_[v] = next_rank++;
+          dg.contracted[v] = 1;
+        } else {
+          remaining[kept++] = v;
+        }
+      }
+      remaining.resize(kept);
+
+      // 全ての近道を求めてからグラフを書き換える．選んだ頂点の隣接頂点は互いに異なるので，書き換えも並列に行える
+      const int n_selected = selected.size();
+      if (int(shortcuts.size()) < n_selected) shortcuts.resize(n_selected);
+      parallel_for_(n_threads, n_selected, 1, [&](int thread_id, int i) {
+        find_shortcuts_(dg, selected[i], witness_settle_limit_, workspaces[thread_id], shortcuts[i]);
+      });
+      parallel_for_(n_threads, n_selected, 1, [&](int, int i) {
+        contract_(dg, selected[i], shortcuts[i], up[selected[i]], down[selected[i]], priority, stale);
+      });
+    }
+
+    up_start_.assign(n_ + 1, 0);
+    down_start_.assign(n_ + 1, 0);
+    for (int v = 0; v < n_; ++v) {
+      up_start_[v + 1] = up_start_[v] + up[v].size();
+      down_start_[v + 1] = down_start_[v] + down[v].size();
+    }
+    up_.reserve(up_start_[n_]);
+    down_.reserve(down_start_[n_]);
+    for (int v = 0; v < n_; ++v) {
+      up_.insert(up_.end(), up[v].begin(), up[v].end());
+      down_.insert(down_.end(), down[v].begin(), down[v].end());
+    }
+  }
+
+  void run_query_(int s, int t) {
+    best_ = INF_;
+    meet_ = -1;
+    settled_count_ = 0;
+    const int source[2] = {s, t};
+    for (int d = 0; d < 2; ++d) {
+      side_[d].next_epoch();
+      side_[d].set(source[d], 0);
+      side_[d].prev_v[source[d]] = -1;
+      side_[d].heap.push(0, source[d]);
+    }
+    if (s == t) {
+      best_ = 0;
+      meet_ = s;
+      return;
+    }
+
+    // 各方向の最小のキーが暫定の最短距離以上になればその方向は終了
+    for (int d = 0; !side_[0].heap.empty() || !side_[1].heap.empty(); d ^= 1) {
+      Workspace &ws = side_[d];
+      if (ws.heap.empty()) continue;
+      auto [du, u] = ws.heap.pop();
+      if (du >= best_) {
+        ws.heap.clear();
+        continue;
+      }
+      ++settled_count_;
+      if (side_[d ^ 1].reached(u) && du + side_[d ^ 1].dist[u] < best_) {
+        best_ = du + side_[d ^ 1].dist[u];
+        meet_ = u;
+      }
+
+      const std::vector<int> &start = d == 0 ? up_start_ : down_start_;
+      const std::vector<Arc> &arcs = d == 0 ? up_ : down_;
+      for (int id = start[u]; id < start[u + 1]; ++id) {
+        const Arc &a = arcs[id];
+        CostType nd = du + a.cost;
+        if (nd < ws.get(a.to)) {
+          ws.set(a.to, nd);
+          ws.prev_v[a.to] = u;
+          ws.prev_arc[a.to] = id;
+          ws.heap.push(nd, a.to);
+        }
+      }
+    }
+  }
+
+  // 近道を含む辺を元の辺の列に展開し，通過する頂点(始点を除く)をoutに追加する
+  // forwardがtrueならa = (from -> a.to)，falseならa = (a.to -> from)
+  void unpack_(int from, const Arc &a, bool forward, std::vector<int> &out) const {
+    int u = forward ? from : a.to, w = forward ? a.to : from;
+    if (a.middle == -1) {
+      out.push_back(w);
+      return;
+    }
+    int m = a.middle;
+    // u -> mはmにおけるdown_の(u)，m -> wはmにおけるup_の(w)
+    const Arc *first = nullptr, *second = nullptr;
+    for (int id = down_start_[m]; id < down_start_[m + 1]; ++id) {
+      if (down_[id].to == u) first = &down_[id];
+    }
+    for (int id = up_start_[m]; id < up_start_[m + 1]; ++id) {
+      if (up_[id].to == w) second = &up_[id];
+    }
+    unpack_(m, *first, false, out);
+    unpack_(m, *second, true, out);
+  }
+};
@@ -0,0 +1,204 @@
+#pragma once
+/**
+ * @file csr_graph.hpp
+ * @brief CSR(Compressed Sparse Row)形式のグラフ。
+ * @details
+ * * 頂点uから出る辺を配列の連続区間[start[u], start[u + 1])に詰めて保持する。
+ * * 隣接リスト(vectorのvector)と異なり、辺の走査でポインタを辿らず、メモリ確保も2回で済む。
+ * * CSRGraph<CostType>は重み付き、CSRGraph<>(CSRGraph<void>)は重みなしのグラフ。
+ * * 構築後は変更しない。探索アルゴリズムはグラフを参照で受け取り、複数のクエリで共有する。
+ */
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief CSRGraphの1頂点から出る辺の範囲。範囲for文で走査できる。
+ */
+template <typename T>
+class CSRRange {
+public:
+  CSRRange(const T *first, const T *last) : first_(first), last_(last) {}
+
+  const T *begin() const { return first_; }
+  const T *end() const { return last_; }
+  int size() const { return last_ - first_; }
+  bool empty() const { return first_ == last_; }
+  const T &operator[](int i) const { return first_[i]; }
+
+private:
+  const T *first_, *last_;
+};
+
+/**
+ * @brief 重み付き有向グラフのCSR表現。
+ * @tparam CostType 辺の重みの型。
+ */
+template <typename CostType = void>
+class CSRGraph {
+public:
+  struct Edge {
+    int to;
+    CostType cost;
+  };
+
+  CSRGraph() : n_(0), start_(1, 0) {}
+
+  /**
+   * @brief 辺のリストから構築する。O(N + M)
+   *
+   * @param n 頂点数
+   * @param edges (始点，終点，重み)の配列
+   */
+  CSRGraph(int n, const std::vector<std::tuple<int, int, CostType>> &edges) : n_(n), start_(n + 1, 0) {
+    for (const auto &[from, to, cost] : edges) ++start_[from + 1];
+    for (int i = 0; i < n_; ++i) start_[i + 1] += start_[i];
+    edges_.resize(edges.size());
+    std::vector<int> pos(start_.begin(), start_.end() - 1);
+    for (const auto &[from, to, cost] : edges) edges_[pos[from]++] = Edge{to, cost};
+  }
+
+  /**
+   * @brief 隣接リストから構築する。O(N + M)
+   *
+   * @param g g[u]がuから出る(終点，重み)の配列であるような隣接リスト
+   */
+  explicit CSRGraph(const std::vector<std::vector<std::pair<int, CostType>>> &g) : n_(g.size()), start_(g.size() + 1, 0) {
+    for (int i = 0; i < n_; ++i) start_[i + 1] = start_[i] + g[i].size();
+    edges_.reserve(start_[n_]);
+    for (const auto &adj : g) {
+      for (const auto &[to, cost] : adj) edges_.push_back(Edge{to, cost});
+    }
+  }
+
+  /**
+   * @brief 重みなしの隣接リストから，全ての辺の重みをunit_costとして構築する。O(N + M)
+   */
+  CSRGraph(const std::vector<std::vector<int>> &g, CostType unit_cost) : n_(g.size()), start_(g.size() + 1, 0) {
+    for (int i = 0; i < n_; ++i) start_[i + 1] = start_[i] + g[i].size();
+    edges_.reserve(start_[n_]);
+    for (const auto &adj : g) {
+      for (int to : adj) edges_.push_back(Edge{to, unit_cost});
+    }
+  }
+
+  int size() const { return n_; }
+  int edge_count() const { return edges_.size(); }
+
+  /**
+   * @brief 頂点uから出る辺の範囲を返す
+   */
+  CSRRange<Edge> adj(int u) const {
+    return CSRRange<Edge>(edges_.data() + start_[u], edges_.data() + start_[u + 1]);
+  }
+
+  /**
+   * @brief 頂点uから出る辺の，全ての辺の中での番号の始まり
+   */
+  int offset(int u) const { return start_[u]; }
+
+  const Edge &edge(int id) const { return edges_[id]; }
+
+  /**
+   * @brief 全ての辺を逆向きにしたグラフを返す。O(N + M)
+   */
+  CSRGraph<CostType> reversed() const {
+    CSRGraph<CostType> ret;
+    ret.n_ = n_;
+    ret.start_.assign(n_ + 1, 0);
+    for (const Edge &e : edges_) ++ret.start_[e.to + 1];
+    for (int i = 0; i < n_; ++i) ret.start_[i + 1] += ret.start_[i];
+    ret.edges_.resize(edges_.size());
+    std::vector<int> pos(ret.start_.begin(), ret.start_.end() - 1);
+    for (int u = 0; u < n_; ++u) {
+      for (const Edge &e : adj(u)) ret.edges_[pos[e.to]++] = Edge{u, e.cost};
+    }
+    return ret;
+  }
+
+  /**
+   * @brief 辺の重みの最大値を返す。辺がなければCostType()。
+   */
+  CostType max_cost() const {
+    CostType ret = CostType();
+    for (const Edge &e : edges_) ret = std::max(ret, e.cost);
+    return ret;
+  }
+
+private:
+  int n_;
+  std::vector<int> start_;
+  std::vector<Edge> edges_;
+};
+
+/**
+ * @brief 重みなし有向グラフのCSR表現。
+ */
+template <>
+class CSRGraph<void> {
+public:
+  CSRGraph() : n_(0), start_(1, 0) {}
+
+  /**
+   * @brief 辺のリストから構築する。O(N + M)
+   *
+   * @param n 頂点数
+   * @param edges (始点，終点)の配列
+   */
+  CSRGraph(int n, const std::vector<std::pair<int, int>> &edges) : n_(n), start_(n + 1, 0) {
+    for (const auto &[from, to] : edges) ++start_[from + 1];
+    for (int i = 0; i < n_; ++i) start_[i + 1] += start_[i];
+    to_.resize(edges.size());
+    std::vector<int> pos(start_.begin(), start_.end() - 1);
+    for (const auto &[from, to] : edges) to_[pos[from]++] = to;
+  }
+
+  /**
+   * @brief 隣接リストから構築する。O(N + M)
+   */
+  explicit CSRGraph(const std::vector<std::vector<int>> &g) : n_(g.size()), start_(g.size() + 1, 0) {
+    for (int i = 0; i < n_; ++i) start_[i + 1] = start_[i] + g[i].size();
+    to_.reserve(start_[n_]);
+    for (const auto &adj : g) to_.insert(to_.end(), adj.begin(), adj.end());
+  }
+
+  /**
+   * @brief 構築済みの配列から直接構築する。start.size() == n + 1であり，startは広義単調増加である必要がある。
+   */
+  CSRGraph(std::vector<int> start, std::vector<int> to) : n_(int(start.size()) - 1), start_(std::move(start)), to_(std::move(to)) {}
+
+  int size() const { return n_; }
+  int edge_count() const { return to_.size(); }
+
+  /**
+   * @brief 頂点uから出る辺の終点の範囲を返す
+   */
+  CSRRange<int> adj(int u) const {
+    return CSRRange<int>(to_.data() + start_[u], to_.data() + start_[u + 1]);
+  }
+
+  int offset(int u) const { return start_[u]; }
+
+  int out_degree(int u) const { return start_[u + 1] - start_[u]; }
+
+  /**
+   * @brief 全ての辺を逆向きにしたグラフを返す。O(N + M)
+   */
+  CSRGraph<void> reversed() const {
+    std::vector<int> start(n_ + 1, 0), to(to_.size());
+    for (int v : to_) ++start[v + 1];
+    for (int i = 0; i < n_; ++i) start[i + 1] += start[i];
+    std::vector<int> pos(start.begin(), start.end() - 1);
+    for (int u = 0; u < n_; ++u) {
+      for (int v : adj(u)) to[pos[v]++] = u;
+    }
+    return CSRGraph<void>(std::move(start), std::move(to));
+  }
+
+private:
+  int n_;
+  std::vector<int> start_;
+  std::vector<int> to_;
+};
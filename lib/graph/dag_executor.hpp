@@ -0,0 +1,177 @@
+#pragma once
+/**
+ * @file dag_executor.hpp
+ * @brief DAGの各頂点をタスクとして，依存関係を守りながら並列に実行する
+ * @details
+ * * 辺u → vは，タスクuが終わってからタスクvを始めることを表す．
+ * * 各タスクの残りの入次数をatomicに持ち，先行するタスクが終わる度に減らす．
+ *   0にしたスレッドが，そのタスクを自分のキューに入れる．
+ * * 各スレッドは自分のキューの末尾から取り出し(LIFO)，空なら他のスレッドのキューの先頭から盗む(work stealing)．
+ *   キューはスレッド毎のmutexで守る．
+ * * Priority::CRITICAL_PATHでは，各タスクから始まる最長路のコストの和(クリティカルパス長)が大きいタスクを優先する．
+ *   キューはクリティカルパス長の二分ヒープになり，盗むときも最大のものを取る．
+ * * 閉路上のタスクやその後続は実行されない．実行中・実行待ちのタスクがなくなった時点で終了する．
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "topological_sort.hpp"
+
+class DagExecutor {
+public:
+  enum class Priority { NONE, CRITICAL_PATH };
+
+  /**
+   * @brief DagExecutorクラスのコンストラクタ
+   *
+   * @param g 依存関係を表すグラフ．参照で保持するので，DagExecutorより長く生存している必要がある
+   * @param n_threads 使うスレッド数(runを呼んだスレッドを含む)
+   * @param priority 実行待ちのタスクを選ぶ基準
+   * @param cost クリティカルパス長の計算に使う各タスクのコスト．空なら全て1，そうでなければ長さNである必要がある
+   */
+  DagExecutor(const CSRGraph<> &g, int n_threads = 1, Priority priority = Priority::NONE,
+              const std::vector<long long> &cost = std::vector<long long>())
+    : g_(g), n_(g.size()), n_threads_(std::max(n_threads, 1)), priority_(priority),
+      in_degree_(n_, 0), remaining_(new std::atomic<int>[n_]), queues_(new Queue[n_threads_])
+  {
+    assert(cost.empty() || int(cost.size()) == n_);
+    for (int u = 0; u < n_; ++u) {
+      for (int v : g_.adj(u)) ++in_degree_[v];
+    }
+    if (priority_ == Priority::CRITICAL_PATH) init_critical_path_(cost);
+  }
+
+  /**
+   * @brief 全てのタスクをtask(v)で実行する．taskは複数のスレッドから同時に呼ばれる
+   *
+   * @return 全てのタスクを実行できたか(閉路がなければtrue)
+   */
+  template <class F>
+  bool run(F task) {
+    for (int v = 0; v < n_; ++v) remaining_[v].store(in_degree_[v], std::memory_order_relaxed);
+    executed_.store(0, std::memory_order_relaxed);
+    int n_ready = 0;
+    for (int v = 0; v < n_; ++v) {
+      if (in_degree_[v] == 0) push_(n_ready++ % n_threads_, v);
+    }
+    active_.store(n_ready, std::memory_order_relaxed);
+
+    auto worker = [&](int t) {
+      int u;
+      while (true) {
+        if (!take_(t, u)) {
+          if (active_.load(std::memory_order_acquire) == 0) return;
+          std::this_thread::yield();
+          continue;
+        }
+        task(u);
+        for (int v : g_.adj(u)) {
+          if (remaining_[v].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            active_.fetch_add(1, std::memory_order_relaxed);
+            push_(t, v);
+          }
+        }
+        executed_.fetch_add(1, std::memory_order_relaxed);
+        active_.fetch_sub(1, std::memory_order_acq_rel);
+      }
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < n_threads_; ++t) threads.emplace_back(worker, t);
+    worker(0);
+    for (std::thread &th : threads) th.join();
+    return executed_.load(std::memory_order_relaxed) == n_;
+  }
+
+  /**
+   * @brief 直前のrunで実行したタスクの数
+   */
+  int executed_count() const { return executed_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief タスクvから始まる最長路のコストの和．Priority::CRITICAL_PATHのときのみ有効
+   */
+  long long critical_path(int v) const {
+    assert(priority_ == Priority::CRITICAL_PATH);
+    return critical_path_[v];
+  }
+
+private:
+  // tasks[head, tasks.size())が実行待ちのタスク．先頭から盗むとheadが進み，空になったら詰め直す
+  struct alignas(64) Queue {
+    std::mutex mutex;
+    std::vector<int> tasks;
+    std::size_t head = 0;
+  };
+
+  const CSRGraph<> &g_;
+  int n_, n_threads_;
+  Priority priority_;
+  std::vector<int> in_degree_;
+  std::vector<long long> critical_path_;
+  std::unique_ptr<std::atomic<int>[]> remaining_;
+  std::unique_ptr<Queue[]> queues_;
+  // 実行待ちか実行中のタスクの数
+  std::atomic<int> active_{0};
+  std::atomic<int> executed_{0};
+
+  void init_critical_path_(const std::vector<long long> &cost) {
+    critical_path_.resize(n_);
+    for (int v = 0; v < n_; ++v) critical_path_[v] = cost.empty() ? 1 : cost[v];
+    // 閉路があればsorted()は空になり，コストのみを使う
+    std::vector<int> order = TopologicalSort(g_).sorted();
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+      long long longest = 0;
+      for (int v : g_.adj(*it)) longest = std::max(longest, critical_path_[v]);
+      critical_path_[*it] += longest;
+    }
+  }
+
+  bool less_(int u, int v) const { return critical_path_[u] < critical_path_[v]; }
+
+  void push_(int t, int v) {
+    Queue &q = queues_[t];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    q.tasks.push_back(v);
+    if (priority_ == Priority::CRITICAL_PATH) {
+      std::push_heap(q.tasks.begin(), q.tasks.end(), [this](int a, int b) { return less_(a, b); });
+    }
+  }
+
+  // キューqから1つ取り出す．stealなら先頭，そうでなければ末尾から取る
+  bool pop_(Queue &q, bool steal, int &v) {
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.head == q.tasks.size()) return false;
+    if (priority_ == Priority::CRITICAL_PATH) {
+      // ヒープではheadは常に0
+      std::pop_heap(q.tasks.begin(), q.tasks.end(), [this](int a, int b) { return less_(a, b); });
+      v = q.tasks.back();
+      q.tasks.pop_back();
+    } else if (steal) {
+      v = q.tasks[q.head++];
+    } else {
+      v = q.tasks.back();
+      q.tasks.pop_back();
+    }
+    if (q.head == q.tasks.size()) {
+      q.tasks.clear();
+      q.head = 0;
+    }
+    return true;
+  }
+
+  // 自分のキュー，他のスレッドのキューの順に探す
+  bool take_(int t, int &v) {
+    if (pop_(queues_[t], false, v)) return true;
+    for (int k = 1; k < n_threads_; ++k) {
+      if (pop_(queues_[(t + k) % n_threads_], true, v)) return true;
+    }
+    return false;
+  }
+};
@@ -0,0 +1,260 @@
+#pragma once
+/**
+ * @file delta_stepping.hpp
+ * @brief Δ-steppingによる並列単一始点最短路
+ * @details
+ * * DeltaStepping
+ *   * 距離を幅Δのバケットに分け，小さいバケットから順に確定させる．
+ *   * 重みΔ以下の辺(軽い辺)の緩和は，バケットが空になるまで複数のスレッドで並列に繰り返す．
+ *   * バケットが空になったら，そのバケットで確定した頂点から出る重い辺をまとめて並列に緩和する．
+ *   * 距離はstd::atomicで保持し，compare_exchangeによるatomicなminで更新する．
+ *   * バケットは環状配列で，長さは(重みの最大値) / Δ + 2以上の2冪．
+ *   * 求めるのは距離のみで，最短路木は求めない．
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "csr_graph.hpp"
+
+namespace delta_stepping_internal {
+
+/**
+ * @brief 全スレッドが到着するまで待つバリア
+ */
+class SpinBarrier {
+public:
+  explicit SpinBarrier(int n) : n_(n), count_(0), generation_(0) {}
+
+  void wait() {
+    unsigned gen = generation_.load(std::memory_order_acquire);
+    if (count_.fetch_add(1, std::memory_order_acq_rel) + 1 == n_) {
+      count_.store(0, std::memory_order_relaxed);
+      generation_.fetch_add(1, std::memory_order_release);
+    } else {
+      while (generation_.load(std::memory_order_acquire) == gen) std::this_thread::yield();
+    }
+  }
+
+private:
+  const int n_;
+  std::atomic<int> count_;
+  std::atomic<unsigned> generation_;
+};
+
+} // namespace delta_stepping_internal
+
+/**
+ * @brief Δ-steppingで単一始点最短路を求めるクラス
+ * @tparam CostType 辺の重みの型．非負である必要がある．
+ */
+template <typename CostType>
+class DeltaStepping {
+public:
+  /**
+   * @brief DeltaSteppingクラスのコンストラクタ．作業用の配列を確保する．O(N + M)
+   *
+   * @param g グラフ．DeltaSteppingより長く生存している必要がある．
+   * @param delta バケットの幅．0以下なら(重みの最大値) × N / Mを[1, 重みの最大値]に収めた値とする．
+   * @param n_threads 使うスレッド数．
+   */
+  explicit DeltaStepping(const CSRGraph<CostType> &g, CostType delta = CostType(0), int n_threads = 1)
+    : g_(&g), n_threads_(std::max(n_threads, 1)), dist_(new std::atomic<CostType>[g.size()]),
+      phase_stamp_(new std::atomic<std::uint64_t>[g.size()]),
+      bucket_stamp_(new std::atomic<std::uint64_t>[g.size()]),
+      buckets_(n_threads_), settled_(n_threads_)
+  {
+    CostType max_cost = g.max_cost();
+    if (!(delta > CostType(0))) {
+      // CostTypeのままではmax_cost * Nがあふれうるのでlong doubleで計算する
+      long double d = g.edge_count() == 0 ? 1.0L : static_cast<long double>(max_cost) * g.size() / g.edge_count();
+      d = std::min(d, static_cast<long double>(max_cost));
+      if (std::is_integral<CostType>::value) d = std::max(d, 1.0L);
+      delta = static_cast<CostType>(d);
+      if (!(delta > CostType(0))) delta = max_cost > CostType(0) ? max_cost : CostType(1);
+    }
+    delta_ = delta;
+    std::size_t need = static_cast<std::size_t>(max_cost / delta_) + 2, n_buckets = 1;
+    while (n_buckets < need) n_buckets <<= 1;
+    mask_ = n_buckets - 1;
+    for (auto &b : buckets_) b.resize(n_buckets);
+    for (int v = 0; v < g.size(); ++v) {
+      dist_[v].store(INF_, std::memory_order_relaxed);
+      phase_stamp_[v].store(0, std::memory_order_relaxed);
+      bucket_stamp_[v].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief srcからの最短距離を求める．
+   */
+  void solve(int src) {
+    for (int v = 0; v < g_->size(); ++v) dist_[v].store(INF_, std::memory_order_relaxed);
+    for (auto &bs : buckets_) {
+      for (auto &b : bs) b.clear();
+    }
+    phase_count_ = 0;
+    dist_[src].store(CostType(0), std::memory_order_relaxed);
+    buckets_[0][0].push_back(src);
+    cur_ = 0;
+    done_ = false;
+    heavy_ = false;
+    prepare_light_();
+
+    delta_stepping_internal::SpinBarrier barrier(n_threads_);
+    auto worker = [&](int thread_id) {
+      while (true) {
+        barrier.wait();
+        if (done_) break;
+        process_(thread_id);
+        barrier.wait();
+        if (thread_id == 0) advance_();
+      }
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < n_threads_; ++t) threads.emplace_back(worker, t);
+    worker(0);
+    for (std::thread &th : threads) th.join();
+  }
+
+  bool is_reachable(int t) const {
+    return dist_[t].load(std::memory_order_relaxed) != INF_;
+  }
+
+  /**
+   * @brief 頂点tまでの距離を返す．到達不可能ならCostTypeの最大値．
+   */
+  CostType distance_to(int t) const {
+    return dist_[t].load(std::memory_order_relaxed);
+  }
+
+  CostType delta() const {
+    return delta_;
+  }
+
+  /**
+   * @brief 直前のsolveで行った緩和のフェーズ数(スレッド間の同期の回数)
+   */
+  int phase_count() const {
+    return phase_count_;
+  }
+
+private:
+  static constexpr CostType INF_ = std::numeric_limits<CostType>::max();
+  // 1度にスレッドが取る頂点数
+  static constexpr std::size_t CHUNK_ = 256;
+
+  const CSRGraph<CostType> *g_;
+  const int n_threads_;
+  CostType delta_;
+  std::size_t mask_;
+  std::unique_ptr<std::atomic<CostType>[]> dist_;
+  // 同じフェーズ，同じバケットで頂点を重複して処理しないための印
+  std::unique_ptr<std::atomic<std::uint64_t>[]> phase_stamp_, bucket_stamp_;
+  std::uint64_t phase_id_ = 0, bucket_id_ = 0;
+  // buckets_[t][i]はスレッドtが追加した，バケット番号がiと合同な頂点
+  std::vector<std::vector<std::vector<int>>> buckets_;
+  // settled_[t]はスレッドtが現在のバケットで処理した頂点
+  std::vector<std::vector<int>> settled_;
+  std::vector<int> frontier_;
+  std::atomic<std::size_t> next_{0};
+  long long cur_ = 0;
+  bool done_ = false, heavy_ = false;
+  int phase_count_ = 0;
+
+  long long bucket_of_(CostType d) const {
+    return static_cast<long long>(d / delta_);
+  }
+
+  void relax_(int thread_id, int v, CostType nd) {
+    CostType old = dist_[v].load(std::memory_order_relaxed);
+    while (nd < old) {
+      if (dist_[v].compare_exchange_weak(old, nd, std::memory_order_relaxed)) {
+        buckets_[thread_id][bucket_of_(nd) & mask_].push_back(v);
+        return;
+      }
+    }
+  }
+
+  // frontier_の頂点を各スレッドで分担して処理する
+  void process_(int thread_id) {
+    const std::size_t size = frontier_.size();
+    for (std::size_t i; (i = next_.fetch_add(CHUNK_, std::memory_order_relaxed)) < size;) {
+      const std::size_t end = std::min(size, i + CHUNK_);
+      for (; i < end; ++i) {
+        int u = frontier_[i];
+        CostType du = dist_[u].load(std::memory_order_relaxed);
+        if (heavy_) {
+          for (const auto &e : g_->adj(u)) {
+            if (e.cost > delta_) relax_(thread_id, e.to, du + e.cost);
+          }
+          continue;
+        }
+        // 既により小さいバケットに移った頂点，同じフェーズで処理済みの頂点は飛ばす
+        if (bucket_of_(du) != cur_) continue;
+        if (phase_stamp_[u].exchange(phase_id_, std::memory_order_relaxed) == phase_id_) continue;
+        if (bucket_stamp_[u].exchange(bucket_id_, std::memory_order_relaxed) != bucket_id_) {
+          settled_[thread_id].push_back(u);
+        }
+        for (const auto &e : g_->adj(u)) {
+          if (!(e.cost > delta_)) relax_(thread_id, e.to, du + e.cost);
+        }
+      }
+    }
+  }
+
+  // 現在のバケットの中身をfrontier_に移す．空ならfalse
+  bool gather_bucket_() {
+    frontier_.clear();
+    for (auto &bs : buckets_) {
+      auto &b = bs[cur_ & mask_];
+      frontier_.insert(frontier_.end(), b.begin(), b.end());
+      b.clear();
+    }
+    return !frontier_.empty();
+  }
+
+  void prepare_light_() {
+    ++bucket_id_;
+    gather_bucket_();
+    ++phase_id_;
+    heavy_ = false;
+    next_.store(0, std::memory_order_relaxed);
+  }
+
+  // 1つのフェーズが終わった後，次のフェーズの準備をする(スレッド0のみ)
+  void advance_() {
+    ++phase_count_;
+    next_.store(0, std::memory_order_relaxed);
+    if (!heavy_) {
+      if (gather_bucket_()) {
+        ++phase_id_;
+        return;
+      }
+      // 現在のバケットが空になったので，確定した頂点の重い辺を緩和する
+      heavy_ = true;
+      for (auto &s : settled_) {
+        frontier_.insert(frontier_.end(), s.begin(), s.end());
+        s.clear();
+      }
+      if (!frontier_.empty()) return;
+    }
+    // 次の空でないバケットを探す
+    for (std::size_t step = 1; step <= mask_; ++step) {
+      bool found = false;
+      for (const auto &bs : buckets_) found |= !bs[(cur_ + step) & mask_].empty();
+      if (found) {
+        cur_ += step;
+        prepare_light_();
+        return;
+      }
+    }
+    done_ = true;
+  }
+};
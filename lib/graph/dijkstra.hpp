@@ -1,15 +1,47 @@
 #pragma once
+/**
+ * @file dijkstra.hpp
+ * @brief Dijkstra法に関するコード
+ * @details
+ * * Dijkstra
+ *   * 隣接リストをコピーして保持し，コンストラクタで単一始点最短路を求める．
+ * * CSRDijkstra
+ *   * CSRGraphを参照で受け取り，同じグラフに対する単一始点最短路を何度も求める．
+ *   * 距離などの配列は最初に1度だけ確保し，クエリ毎の初期化はエポック番号の更新のみ(O(1))．
+ *   * ヒープはDaryHeap(decrease-keyあり)またはRadixHeap(整数の重みのみ)から選ぶ．
+ *   * 終点を与えると，終点が確定した時点で探索を打ち切る．
+ *   * 許容的なヒューリスティック関数を与えるとA*探索を行う．
+ *   * 重みが小さい整数の場合はZeroOneQueue(0-1 BFS)，DialQueue(Dial法)も使える．
+ *     AutoQueueを指定すれば，重みの最大値からこれらとRadixHeapのいずれかを自動で選ぶ．
+ *   * 始点を複数与えると，各頂点について最も近い始点までの距離とその始点を求める．
+ * * distance_matrix
+ *   * 複数の始点から複数の終点への距離行列を，スレッド毎のCSRDijkstraで並列に求める．
+ *   * グラフは全スレッドで共有し，結果は1つの連続した配列に書き込む．
+ * * BidirectionalDijkstra
+ *   * 始点からの探索と終点からの逆向きの探索を交互に進める2点間最短路．
+ *   * 両側で最後に取り出した距離の和が暫定の最短距離以上になった時点で停止する．
+ * @example dijkstra_test.cpp
+ */
 
 #include <algorithm>
+#include <atomic>
 #include <queue>
 #include <limits>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "csr_graph.hpp"
+#include "../bucket_queue.hpp"
+#include "../dary_heap.hpp"
+#include "../radix_heap.hpp"
+
 template <typename CostType>
 class Dijkstra {
   using State = std::pair<CostType, int>;
 public:
-  Dijkstra(const std::vector<std::vector<pair<int, CostType>>> &g, int src)
+  Dijkstra(const std::vector<std::vector<std::pair<int, CostType>>> &g, int src)
     : _src(src), _g(g), _dist(g.size(), _INF), _prev(g.size(), -1)
   {
     _dist[src] = 0;
@@ -81,4 +113,420 @@ private:
       }
     }
   }
-};
\ No newline at end of file
+};
+
+/**
+ * @brief 重みの最大値に応じて0-1 BFS，Dial法，Radix Heapを切り替える優先度付きキュー
+ * @details CSRDijkstraに渡すと，構築時にconfigure(重みの最大値)が呼ばれる．
+ *   ZeroOneQueueを選んだ場合，solve_astarは使えない．
+ * @tparam Key 整数の重みの型．
+ */
+template <typename Key>
+class AutoQueue {
+  static_assert(std::is_integral<Key>::value, "AutoQueue requires an integral key");
+
+public:
+  enum class Mode { ZERO_ONE, DIAL, RADIX };
+
+  // これ以下の重みの最大値ではDial法を使う
+  static constexpr Key DIAL_LIMIT = 1 << 12;
+
+  explicit AutoQueue(int n = 0) : mode_(Mode::RADIX), radix_(n) {}
+
+  void configure(Key max_cost) {
+    if (max_cost <= 1) {
+      mode_ = Mode::ZERO_ONE;
+    } else if (max_cost <= DIAL_LIMIT) {
+      mode_ = Mode::DIAL;
+      dial_.reserve(max_cost);
+    } else {
+      mode_ = Mode::RADIX;
+    }
+  }
+
+  Mode mode() const { return mode_; }
+
+  bool empty() const {
+    switch (mode_) {
+      case Mode::ZERO_ONE: return zero_one_.empty();
+      case Mode::DIAL: return dial_.empty();
+      default: return radix_.empty();
+    }
+  }
+
+  void push(Key key, int v) {
+    switch (mode_) {
+      case Mode::ZERO_ONE: zero_one_.push(key, v); break;
+      case Mode::DIAL: dial_.push(key, v); break;
+      default: radix_.push(key, v); break;
+    }
+  }
+
+  std::pair<Key, int> pop() {
+    switch (mode_) {
+      case Mode::ZERO_ONE: return zero_one_.pop();
+      case Mode::DIAL: return dial_.pop();
+      default: return radix_.pop();
+    }
+  }
+
+  void clear() {
+    zero_one_.clear();
+    dial_.clear();
+    radix_.clear();
+  }
+
+private:
+  Mode mode_;
+  ZeroOneQueue<Key> zero_one_;
+  DialQueue<Key> dial_;
+  RadixHeap<Key> radix_;
+};
+
+namespace dijkstra_internal {
+
+template <class Heap, class = void>
+struct has_configure : std::false_type {};
+
+template <class Heap>
+struct has_configure<Heap, std::void_t<decltype(std::declval<Heap &>().configure(0))>> : std::true_type {};
+
+} // namespace dijkstra_internal
+
+/**
+ * @brief CSRGraph上で単一始点最短路を繰り返し求めるクラス
+ * @tparam CostType 辺の重みの型．
+ * @tparam Heap 優先度付きキュー．push(key, v)，pop()，empty()，clear()を持つ．
+ *   DaryHeap<CostType>(既定)，RadixHeap<CostType>，ZeroOneQueue<CostType>，DialQueue<CostType>，
+ *   AutoQueue<CostType>のいずれか．
+ */
+template <typename CostType, class Heap = DaryHeap<CostType>>
+class CSRDijkstra {
+public:
+  /**
+   * @brief CSRDijkstraクラスのコンストラクタ．作業用の配列を確保する．O(N)
+   *
+   * @param g グラフ．CSRDijkstraより長く生存している必要がある．
+   */
+  explicit CSRDijkstra(const CSRGraph<CostType> &g)
+    : g_(&g), dist_(g.size()), prev_(g.size()), origin_(g.size()), stamp_(g.size(), 0), epoch_(0), heap_(g.size())
+  {
+    if constexpr (dijkstra_internal::has_configure<Heap>::value) heap_.configure(g.max_cost());
+  }
+
+  /**
+   * @brief srcからの最短路を求める．O(M log N)
+   */
+  void solve(int src) {
+    run_(src, -1, [](int) { return CostType(0); });
+  }
+
+  /**
+   * @brief 複数の始点からの最短路を求める．各頂点について最も近い始点までの距離を求める．O(M log N)
+   * @details 実行後，source_of(v)で最も近い始点が分かる．path_to(v)はその始点からの経路を返す．
+   */
+  void solve(const std::vector<int> &sources) {
+    start_(sources);
+    while (!heap_.empty()) {
+      auto [du, u] = heap_.pop();
+      if (dist_[u] != du) continue;
+      ++settled_count_;
+      relax_(u, du);
+    }
+  }
+
+  /**
+   * @brief srcからtargetへの最短路を求める．targetが確定した時点で探索を打ち切る．
+   * @details 実行後はtargetと，その最短路上の頂点に関する結果のみが有効．
+   */
+  void solve(int src, int target) {
+    run_(src, target, [](int) { return CostType(0); });
+  }
+
+  /**
+   * @brief A*探索でsrcからtargetへの最短路を求める．
+   * @details 実行後はtargetと，その最短路上の頂点に関する結果のみが有効．
+   *
+   * @param heuristic 頂点vからtargetまでの距離の下界を返す関数．CostType(int)として呼び出せる．
+   *   RadixHeapを使う場合は，辺(u, v)に対してh(u) <= c(u, v) + h(v)を満たす(consistentである)必要がある．
+   */
+  template <class Heuristic>
+  void solve_astar(int src, int target, Heuristic heuristic) {
+    run_(src, target, heuristic);
+  }
+
+  /**
+   * @brief 直前のsolveでヒープから取り出して確定させた頂点数
+   */
+  int settled_count() const {
+    return settled_count_;
+  }
+
+  bool is_reachable(int t) const {
+    return stamp_[t] == epoch_;
+  }
+
+  /**
+   * @brief 頂点tまでの距離を返す．到達不可能ならCostTypeの最大値．
+   */
+  CostType distance_to(int t) const {
+    return is_reachable(t) ? dist_[t] : INF_;
+  }
+
+  std::vector<int> path_to(int t) const {
+    if (!is_reachable(t)) return std::vector<int>();
+    std::vector<int> res;
+    for (int pos = t; pos != -1; pos = prev_[pos]) res.push_back(pos);
+    std::reverse(std::begin(res), std::end(res));
+    return res;
+  }
+
+  /**
+   * @brief 最短路木における頂点vの親を返す．始点または到達不可能なら-1．
+   */
+  int prev(int v) const {
+    return is_reachable(v) ? prev_[v] : -1;
+  }
+
+  /**
+   * @brief 頂点vへの最短路の始点を返す．複数始点の場合は最も近い始点．到達不可能なら-1．
+   */
+  int source_of(int v) const {
+    return is_reachable(v) ? origin_[v] : -1;
+  }
+
+private:
+  template <typename, class> friend class BidirectionalDijkstra;
+
+  static constexpr CostType INF_ = std::numeric_limits<CostType>::max();
+  const CSRGraph<CostType> *g_;
+  int src_ = -1;
+  int settled_count_ = 0;
+  std::vector<CostType> dist_;
+  std::vector<int> prev_;
+  // origin_[v]はvへの最短路の始点
+  std::vector<int> origin_;
+  // stamp_[v] == epoch_のときのみdist_[v]，prev_[v]が有効
+  std::vector<unsigned> stamp_;
+  unsigned epoch_;
+  Heap heap_;
+
+  void next_epoch_() {
+    if (++epoch_ == 0) {
+      std::fill(stamp_.begin(), stamp_.end(), 0);
+      epoch_ = 1;
+    }
+  }
+
+  void reach_(int v, CostType d, int from) {
+    stamp_[v] = epoch_;
+    dist_[v] = d;
+    prev_[v] = from;
+    origin_[v] = from == -1 ? v : origin_[from];
+  }
+
+  void start_(int src) {
+    next_epoch_();
+    src_ = src;
+    settled_count_ = 0;
+    heap_.clear();
+    reach_(src, 0, -1);
+  }
+
+  void start_(const std::vector<int> &sources) {
+    next_epoch_();
+    src_ = sources.empty() ? -1 : sources.front();
+    settled_count_ = 0;
+    heap_.clear();
+    for (int src : sources) {
+      if (is_reachable(src)) continue;
+      reach_(src, 0, -1);
+      heap_.push(0, src);
+    }
+  }
+
+  void relax_(int u, CostType du) {
+    for (const auto &e : g_->adj(u)) {
+      CostType new_dv = du + e.cost;
+      if (!is_reachable(e.to) || dist_[e.to] > new_dv) {
+        reach_(e.to, new_dv, u);
+        heap_.push(new_dv, e.to);
+      }
+    }
+  }
+
+  // ヒープのキーは 距離 + heuristic(v)．heuristicが常に0なら通常のDijkstra法
+  template <class Heuristic>
+  void run_(int src, int target, Heuristic heuristic) {
+    start_(src);
+    heap_.push(heuristic(src), src);
+
+    while (!heap_.empty()) {
+      auto [key, u] = heap_.pop();
+      CostType du = dist_[u];
+      if (du + heuristic(u) != key) continue;
+      ++settled_count_;
+      if (u == target) break;
+
+      for (const auto &e : g_->adj(u)) {
+        CostType new_dv = du + e.cost;
+        if (!is_reachable(e.to) || dist_[e.to] > new_dv) {
+          reach_(e.to, new_dv, u);
+          heap_.push(new_dv + heuristic(e.to), e.to);
+        }
+      }
+    }
+  }
+};
+
+/**
+ * @brief 双方向Dijkstra法で2点間最短路を求めるクラス
+ * @tparam CostType 辺の重みの型．
+ * @tparam Heap 優先度付きキュー．CSRDijkstraと同じ．
+ */
+template <typename CostType, class Heap = DaryHeap<CostType>>
+class BidirectionalDijkstra {
+public:
+  /**
+   * @brief BidirectionalDijkstraクラスのコンストラクタ．O(N)
+   *
+   * @param g グラフ．
+   * @param rev_g gの全ての辺を逆向きにしたグラフ(g.reversed())．
+   */
+  BidirectionalDijkstra(const CSRGraph<CostType> &g, const CSRGraph<CostType> &rev_g)
+    : forward_(g), backward_(rev_g) {}
+
+  /**
+   * @brief srcからtargetへの最短路を求める．
+   */
+  void solve(int src, int target) {
+    forward_.start_(src);
+    backward_.start_(target);
+    forward_.heap_.push(0, src);
+    backward_.heap_.push(0, target);
+    target_ = target;
+    best_ = INF_;
+    meet_ = src == target ? src : -1;
+    if (src == target) best_ = 0;
+
+    // 各方向で最後に取り出した距離．未発見の経路の長さはこの和以上
+    CostType last[2] = {0, 0};
+    CSRDijkstra<CostType, Heap> *side[2] = {&forward_, &backward_};
+    for (int turn = 0; !forward_.heap_.empty() && !backward_.heap_.empty(); turn ^= 1) {
+      CSRDijkstra<CostType, Heap> &cur = *side[turn];
+      const CSRDijkstra<CostType, Heap> &other = *side[turn ^ 1];
+      auto [du, u] = cur.heap_.pop();
+      if (cur.dist_[u] != du) continue;
+      last[turn] = du;
+      if (best_ != INF_ && last[0] + last[1] >= best_) break;
+      ++cur.settled_count_;
+
+      for (const auto &e : cur.g_->adj(u)) {
+        CostType new_dv = du + e.cost;
+        if (!cur.is_reachable(e.to) || cur.dist_[e.to] > new_dv) {
+          cur.reach_(e.to, new_dv, u);
+          cur.heap_.push(new_dv, e.to);
+          if (other.is_reachable(e.to) && new_dv + other.dist_[e.to] < best_) {
+            best_ = new_dv + other.dist_[e.to];
+            meet_ = e.to;
+          }
+        }
+      }
+    }
+
+    // 出会った頂点からtargetまでの経路を前向きの探索結果に書き込む
+    if (meet_ == -1) return;
+    for (int v = meet_; v != target_;) {
+      int w = backward_.prev_[v];
+      forward_.reach_(w, best_ - backward_.dist_[w], v);
+      v = w;
+    }
+  }
+
+  bool is_reachable(int t) const {
+    return t == target_ ? best_ != INF_ : forward_.is_reachable(t);
+  }
+
+  /**
+   * @brief 終点までの距離を返す．到達不可能ならCostTypeの最大値．
+   */
+  CostType distance_to(int t) const {
+    return t == target_ ? best_ : forward_.distance_to(t);
+  }
+
+  /**
+   * @brief 終点までの最短路を返す．
+   */
+  std::vector<int> path_to(int t) const {
+    if (!is_reachable(t)) return std::vector<int>();
+    return forward_.path_to(t);
+  }
+
+  /**
+   * @brief 最短路上の頂点vの，最短路における直前の頂点を返す．
+   */
+  int prev(int v) const {
+    return forward_.prev(v);
+  }
+
+  /**
+   * @brief 直前のsolveで両方向の探索が確定させた頂点数の合計
+   */
+  int settled_count() const {
+    return forward_.settled_count() + backward_.settled_count();
+  }
+
+private:
+  static constexpr CostType INF_ = std::numeric_limits<CostType>::max();
+  CSRDijkstra<CostType, Heap> forward_, backward_;
+  int target_ = -1, meet_ = -1;
+  CostType best_ = INF_;
+};
+
+/**
+ * @brief sources[i]からtargets[j]への距離を，|sources| × |targets|の行列として求める．
+ * @details 始点を各スレッドに動的に割り当て，スレッド毎に1つのCSRDijkstraを使い回す．
+ *   グラフは読み取りのみなので全スレッドで共有する．
+ *
+ * @param g グラフ．
+ * @param sources 始点の列．
+ * @param targets 終点の列．
+ * @param n_threads 使うスレッド数．
+ * @return 行優先の距離行列．(i, j)成分はret[i * targets.size() + j]．到達不可能ならCostTypeの最大値．
+ */
+template <typename CostType, class Heap = DaryHeap<CostType>>
+std::vector<CostType> distance_matrix(
+  const CSRGraph<CostType> &g, const std::vector<int> &sources, const std::vector<int> &targets, int n_threads = 1
+) {
+  const std::size_t n_targets = targets.size();
+  std::vector<CostType> ret(sources.size() * n_targets);
+  std::atomic<std::size_t> next(0);
+  auto worker = [&]() {
+    CSRDijkstra<CostType, Heap> dijkstra(g);
+    for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < sources.size();) {
+      if (n_targets == 1) {
+        dijkstra.solve(sources[i], targets[0]);
+      } else {
+        dijkstra.solve(sources[i]);
+      }
+      CostType *row = ret.data() + i * n_targets;
+      for (std::size_t j = 0; j < n_targets; ++j) row[j] = dijkstra.distance_to(targets[j]);
+    }
+  };
+  n_threads = std::max(1, std::min<int>(n_threads, sources.size()));
+  std::vector<std::thread> threads;
+  for (int t = 1; t < n_threads; ++t) threads.emplace_back(worker);
+  worker();
+  for (std::thread &th : threads) th.join();
+  return ret;
+}
+
+/**
+ * @brief sources[i]から全頂点への距離を，|sources| × Nの行列として求める．
+ */
+template <typename CostType, class Heap = DaryHeap<CostType>>
+std::vector<CostType> distance_matrix(const CSRGraph<CostType> &g, const std::vector<int> &sources, int n_threads = 1) {
+  std::vector<int> targets(g.size());
+  for (int v = 0; v < g.size(); ++v) targets[v] = v;
+  return distance_matrix<CostType, Heap>(g, sources, targets, n_threads);
+}
@@ -1,40 +1,129 @@
+/**
+ * @file kruskal.hpp
+ * @brief Kruskal法による最小全域森
+ * @details
+ * * 辺は1つの配列に詰めて保持し，solve()で1度だけ重みの昇順に並べる．
+ *   * 重みが整数なら8ビットずつのLSD基数ソート．全ての辺で等しい桁は飛ばす．
+ *   * それ以外は，スレッド毎に区間をソートしてから併合する．
+ * * 辺が非常に多く，複数のコアを使いたい場合はboruvka.hppのBoruvkaも使える．
+ */
 #ifndef OKINA_KRUSKAL
 #define OKINA_KRUSKAL
 
-#include <functional>
-#include <utility>
-#include <queue>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <thread>
 #include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "union_find.hpp"
 
+namespace kruskal_internal {
+
+/**
+ * @brief 整数を，大小関係を保ったまま符号なし整数に写す
+ */
+template <typename T>
+std::make_unsigned_t<T> to_unsigned_key(T x) {
+  using U = std::make_unsigned_t<T>;
+  U ret = static_cast<U>(x);
+  if constexpr (std::is_signed<T>::value) ret ^= U(1) << (sizeof(T) * 8 - 1);
+  return ret;
+}
+
+/**
+ * @brief key(a[i])の昇順にaを安定ソートする．keyは整数を返す．O(n × sizeof(key))
+ */
+template <typename T, class Key>
+void radix_sort(std::vector<T> &a, Key key) {
+  using K = decltype(to_unsigned_key(key(a[0])));
+  const std::size_t n = a.size();
+  std::vector<T> buf(n);
+  for (int shift = 0; shift < int(sizeof(K) * 8); shift += 8) {
+    std::size_t count[257] = {};
+    for (const T &x : a) ++count[((to_unsigned_key(key(x)) >> shift) & 0xff) + 1];
+    // 全ての要素でこの桁が等しければ並べ替える必要はない
+    if (*std::max_element(count + 1, count + 257) == n) continue;
+    for (int i = 0; i < 256; ++i) count[i + 1] += count[i];
+    for (const T &x : a) buf[count[(to_unsigned_key(key(x)) >> shift) & 0xff]++] = x;
+    a.swap(buf);
+  }
+}
+
+/**
+ * @brief aをn_threads個の区間に分けて並列にソートし，併合する．
+ */
+template <typename T, class Compare>
+void parallel_sort(std::vector<T> &a, Compare comp, int n_threads) {
+  const std::size_t n = a.size();
+  n_threads = std::max(1, std::min<int>(n_threads, n / 4096 + 1));
+  std::vector<std::size_t> bound(n_threads + 1);
+  for (int t = 0; t <= n_threads; ++t) bound[t] = n * t / n_threads;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < n_threads; ++t) {
+    threads.emplace_back([&, t] { std::sort(a.begin() + bound[t], a.begin() + bound[t + 1], comp); });
+  }
+  for (std::thread &th : threads) th.join();
+
+  // 隣り合う区間を並列に併合していく
+  for (int width = 1; width < n_threads; width *= 2) {
+    threads.clear();
+    for (int t = 0; t + width < n_threads; t += 2 * width) {
+      std::size_t first = bound[t], middle = bound[t + width], last = bound[std::min(t + 2 * width, n_threads)];
+      threads.emplace_back([&a, comp, first, middle, last] {
+        std::inplace_merge(a.begin() + first, a.begin() + middle, a.begin() + last, comp);
+      });
+    }
+    for (std::thread &th : threads) th.join();
+  }
+}
+
+} // namespace kruskal_internal
+
 template<typename CostType>
 class Kruskal {
   using Edge = std::tuple<int, int, CostType>;
  public:
-  Kruskal(int n) : _n(n), _pq([](Edge a, Edge b) { return std::get<2>(a) > std::get<2>(b); }), _uf(n) {};
+  /**
+   * @brief Kruskalクラスのコンストラクタ
+   *
+   * @param n 頂点数
+   * @param n_threads 重みが整数でない場合に，辺のソートに使うスレッド数
+   */
+  Kruskal(int n, int n_threads = 1) : _n(n), _n_threads(std::max(n_threads, 1)) {};
 
   void add_edge(const int u, const int v, const CostType c) {
-    _pq.emplace(u, v, c);
+    _edges.push_back(FlatEdge{c, u, v});
   }
 
+  /**
+   * @brief 追加された全ての辺に対する最小全域森を求める．O(M log M)，重みが整数ならO(M + N α(N))
+   */
   void solve() {
-    while (!_pq.empty()) {
-      auto [u, v, c] = _pq.top();
-      _pq.pop();
-      if (!_uf.is_same(u, v)) {
-        _uf.unite(u, v);
-        _msf.emplace_back(u, v, c);
-      }
-
-      if (_msf.size() == _n - 1) break;
+    if constexpr (std::is_integral<CostType>::value) {
+      kruskal_internal::radix_sort(_edges, [](const FlatEdge &e) { return e.cost; });
+    } else {
+      kruskal_internal::parallel_sort(
+        _edges, [](const FlatEdge &a, const FlatEdge &b) { return a.cost < b.cost; }, _n_threads
+      );
+    }
+
+    UnionFind uf(_n);
+    _msf.clear();
+    for (const FlatEdge &e : _edges) {
+      if (_msf.size() + 1 >= static_cast<std::size_t>(_n)) break;
+      if (uf.unite(e.u, e.v)) _msf.emplace_back(e.u, e.v, e.cost);
     }
     _is_solved = true;
   }
 
   bool is_mst() const {
     assert(_is_solved);
-    return _msf.size() == _n - 1;
+    return _msf.size() + 1 == static_cast<std::size_t>(_n);
   }
 
   CostType get_cost_sum() const {
@@ -52,11 +141,16 @@ class Kruskal {
   };
 
  private:
+  struct FlatEdge {
+    CostType cost;
+    int u, v;
+  };
+
   int _n;
+  int _n_threads;
   bool _is_solved = false;
-  std::priority_queue<Edge, std::vector<Edge>, std::function<bool(Edge, Edge)>> _pq;
-  UnionFind _uf;
+  std::vector<FlatEdge> _edges;
   std::vector<Edge> _msf;
 };
 
-#endif
\ No newline at end of file
+#endif
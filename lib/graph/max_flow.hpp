@@ -9,14 +9,34 @@
  *   * \f$O(N^2 \sqrt M)\f$で最大フローを求める．
  *   * Highest label selection rule を採用．
  *   * 実装については組合せ最適化 原書6版(コルテ，フィーゲン)を参考にした．
+ * * ResidualGraph
+ *   * 残余グラフ．辺とその逆辺を(行き先，逆辺の位置，残余容量)の組としてCSR順の1つの配列に持つ．
+ *   * Dinic，HLPPが内部で使う．
+ * * Dinic
+ *   * \f$O(N^2 M)\f$で最大フローを求める．
+ *   * 終点からの逆向きBFSで距離を求め，始点から距離が1ずつ減る辺のみを辿って増加路を探す．
+ *   * 増加路の探索は再帰を使わず，各頂点の次に調べる辺の位置を覚えておく．
+ *   * max_flowの後に辺の追加や容量の増加をして，現在のフローから続けて流せる．
+ *     辺を追加した場合は，次のmax_flowで現在のフローを保ったまま残余グラフをO(N + M)で並べ直す．
+ *   * min_cutは残余グラフで始点から到達できる頂点集合を返す．作業用の配列は使い回す．
+ * * HLPP
+ *   * Highest label selection ruleのPush-Relabel法で，\f$O(N^2 \sqrt M)\f$で最大フローを求める．
+ *   * 一定量の再ラベルごとに終点からの逆向きBFSで高さを付け直す(global relabeling)．
+ *   * ある高さの頂点がなくなると，それより高い頂点は終点に到達できないので一斉に取り除く(gap heuristic)．
+ *   * 第1段階で最大フローの値を求め，第2段階で終点に流せなかった余剰を始点に戻してフローにする．
+ *   * Dinicと同じく，辺の追加や容量の増加の後に現在のフローから続けて流せる．
  * * Validation
  *   * FordFulkerson: https://onlinejudge.u-aizu.ac.jp/status/users/okina25/submissions/1/GRL_6_A/judge/8293689/C++17
  *   * PushRelabel: https://onlinejudge.u-aizu.ac.jp/status/users/okina25/submissions/1/GRL_6_A/judge/8296582/C++17
  */
 
+#include <algorithm>
+#include <cassert>
+#include <limits>
 #include <list>
 #include <memory>
 #include <stack>
+#include <utility>
 #include <vector>
 
 template <typename T>
@@ -29,12 +49,12 @@ public:
     const std::vector<std::vector<std::pair<int, T>>> &g,
     const int source, const int sink
   ) : n_(g.size()), source_(source), sink_(sink), inf_(0) {
-    residual_g_.reserve(g.size());
+    residual_g_.resize(g.size());
     int edge_id = 0;
     for (int i = 0; i < g.size(); ++i) {
       for (int j = 0; j < g[i].size(); ++j) {
         auto [to, cap] = g[i][j];
-        inf_ = max(inf_, cap);
+        inf_ = std::max(inf_, cap);
         // Edge: from, to, cap, id_in_all_edge, id_in_adj
         Edge e = {i, to, cap, edge_id, int(residual_g_[i].size())};
         Edge rev_e = {to, i, 0, edge_id + 1, int(residual_g_[to].size())};
@@ -55,7 +75,7 @@ public:
    * @brief \f$O(M)\f$でフローを求める．
    */
   std::vector<std::vector<std::pair<int, T>>> get_flow() const {
-    std::vector<std::vector<int, T>> flow(n_);
+    std::vector<std::vector<std::pair<int, T>>> flow(n_);
     for (int i = 0; i < n_; ++i) {
       flow[i].reserve(residual_g_[i].size() / 2);
       for (Edge edge : residual_g_[i]) {
@@ -102,7 +122,7 @@ private:
       seen[source_] = true;
       if (find_augment_path_(path, path_edges, seen)) {
         T augment_amount = inf_;
-        for (Edge e : path_edges) augment_amount = min(augment_amount, e.cap);
+        for (Edge e : path_edges) augment_amount = std::min(augment_amount, e.cap);
         max_flow_value += augment_amount;
         for (auto [from, to, cap, id_in_all_edge, id_in_adj] : path_edges) {
           if (id_in_all_edge % 2 == 0) {
@@ -137,7 +157,7 @@ public:
       distance_label_(n_, 0), distance_to_active_v_(2 * n_),
       admissible_edge_ids_(n_), excess_amount_(n_, 0), max_flow_value_(0), flow_(n_)
   {
-    residual_g_.reserve(g.size());
+    residual_g_.resize(g.size());
     int edge_id = 0;
     for (int i = 0; i < g.size(); ++i) {
       for (int j = 0; j < g[i].size(); ++j) {
@@ -218,9 +238,9 @@ private:
     distance_label_[v] = 2 * n_;
     for (const std::shared_ptr<Edge> &e : residual_g_[v]) {
       if (e->cap == 0) continue;
-      distance_label_[v] = min(distance_label_[v], distance_label_[e->to] + 1);
+      distance_label_[v] = std::min(distance_label_[v], distance_label_[e->to] + 1);
     }
-    for (const shared_ptr<Edge> &e : residual_g_[v]) {
+    for (const std::shared_ptr<Edge> &e : residual_g_[v]) {
       // 使用可能辺の追加
       if (e->cap > 0 && distance_label_[v] == distance_label_[e->to] + 1) {
         admissible_edge_ids_[v].push_back(e->id_in_all_edge);
@@ -272,7 +292,7 @@ private:
   void delete_non_admissible_edges_() {
     int active_v = distance_to_active_v_[max_active_v_distance_].back();
     while (!admissible_edge_ids_[active_v].empty()) {
-      const shared_ptr<Edge> &e = edges_[admissible_edge_ids_[active_v].back()];
+      const std::shared_ptr<Edge> &e = edges_[admissible_edge_ids_[active_v].back()];
       if (distance_label_[e->from] == distance_label_[e->to] + 1) break;
       admissible_edge_ids_[active_v].pop_back();
     }
@@ -297,3 +317,473 @@ private:
   T max_flow_value_;
   std::vector<std::vector<std::pair<int, T>>> flow_;
 }; // class PushRelabel
+
+/**
+ * @brief 最大フロー用の残余グラフ
+ * @details 辺を追加してからbuild()を呼ぶと，辺と逆辺をCSR順に並べる．
+ *   build()の後に辺を追加した場合，次のbuild()で現在のフローを保ったまま並べ直す．
+ * @tparam T 容量の型．
+ */
+template <typename T>
+class ResidualGraph {
+public:
+  struct Arc {
+    int to;
+    // 逆辺の，arcs_での位置
+    int rev;
+    // 残余容量
+    T cap;
+  };
+
+  struct Edge {
+    int from, to;
+    T cap, flow;
+  };
+
+  explicit ResidualGraph(int n = 0) : n_(n), start_(n + 1, 0) {}
+
+  int size() const { return n_; }
+  int edge_count() const { return from_.size(); }
+
+  /**
+   * @brief fromからtoへの容量capの辺を追加し，その番号を返す．
+   */
+  int add_edge(int from, int to, T cap) {
+    assert(0 <= from && from < n_ && 0 <= to && to < n_ && cap >= 0);
+    from_.push_back(from);
+    to_.push_back(to);
+    cap_.push_back(cap);
+    built_ = false;
+    return from_.size() - 1;
+  }
+
+  /**
+   * @brief 辺をCSR順に並べる．O(N + M)
+   */
+  void build() {
+    if (built_) return;
+    const int m_old = pos_.size(), m = from_.size();
+    std::vector<T> flow(m, 0);
+    for (int id = 0; id < m_old; ++id) flow[id] = arcs_[arcs_[pos_[id]].rev].cap;
+
+    std::fill(start_.begin(), start_.end(), 0);
+    for (int id = 0; id < m; ++id) {
+      ++start_[from_[id] + 1];
+      ++start_[to_[id] + 1];
+    }
+    for (int v = 0; v < n_; ++v) start_[v + 1] += start_[v];
+    arcs_.resize(2 * m);
+    pos_.resize(m);
+    std::vector<int> fill(start_.begin(), start_.end() - 1);
+    for (int id = 0; id < m; ++id) {
+      int a = fill[from_[id]]++, b = fill[to_[id]]++;
+      arcs_[a] = Arc{to_[id], b, cap_[id] - flow[id]};
+      arcs_[b] = Arc{from_[id], a, flow[id]};
+      pos_[id] = a;
+    }
+    built_ = true;
+  }
+
+  bool is_built() const { return built_; }
+
+  // 頂点vから出る弧はarcs_[begin(v), end(v))．build()の後でのみ有効
+  int begin(int v) const { return start_[v]; }
+  int end(int v) const { return start_[v + 1]; }
+  Arc &arc(int i) { return arcs_[i]; }
+  const Arc &arc(int i) const { return arcs_[i]; }
+
+  /**
+   * @brief 弧iの始点．O(1)
+   */
+  int tail(int i) const { return arcs_[arcs_[i].rev].to; }
+
+  /**
+   * @brief 辺idに対応する弧の位置．逆辺はarc(arc_of(id)).rev．build()の後でのみ有効
+   */
+  int arc_of(int id) const { return pos_[id]; }
+
+  /**
+   * @brief 辺idの容量にcapを加える．build()の後でもよい．
+   */
+  void add_capacity(int id, T cap) {
+    assert(cap >= 0);
+    cap_[id] += cap;
+    if (id < int(pos_.size())) arcs_[pos_[id]].cap += cap;
+  }
+
+  /**
+   * @brief 残余グラフでsourceから到達できる頂点を求める．build()の後でのみ有効．O(N + M)
+   *
+   * @param reachable reachable[v]にvが到達可能かを書き込む．
+   * @param queue 作業用の配列．
+   */
+  void reachable_from(int source, std::vector<char> &reachable, std::vector<int> &queue) const {
+    reachable.assign(n_, false);
+    queue.resize(n_);
+    int head = 0, tail = 0;
+    reachable[source] = true;
+    queue[tail++] = source;
+    while (head < tail) {
+      int v = queue[head++];
+      for (int i = begin(v); i < end(v); ++i) {
+        const Arc &a = arcs_[i];
+        if (a.cap == 0 || reachable[a.to]) continue;
+        reachable[a.to] = true;
+        queue[tail++] = a.to;
+      }
+    }
+  }
+
+  /**
+   * @brief 辺idの始点，終点，容量，流量を返す．
+   */
+  Edge get_edge(int id) const {
+    // 最後のbuild()より後に追加された辺にはまだ流れていない
+    T flow = id < int(pos_.size()) ? arcs_[arcs_[pos_[id]].rev].cap : T(0);
+    return Edge{from_[id], to_[id], cap_[id], flow};
+  }
+
+  /**
+   * @brief flow[u]が(v，uからvへの辺の流量)の配列であるようなフローを返す．
+   */
+  std::vector<std::vector<std::pair<int, T>>> get_flow() const {
+    std::vector<std::vector<std::pair<int, T>>> flow(n_);
+    for (int id = 0; id < edge_count(); ++id) {
+      flow[from_[id]].emplace_back(to_[id], get_edge(id).flow);
+    }
+    return flow;
+  }
+
+private:
+  int n_;
+  bool built_ = false;
+  // 追加された辺
+  std::vector<int> from_, to_;
+  std::vector<T> cap_;
+  // pos_[id]は辺idの，arcs_での位置
+  std::vector<int> pos_;
+  std::vector<int> start_;
+  std::vector<Arc> arcs_;
+};
+
+template <typename T>
+class Dinic {
+public:
+  explicit Dinic(int n) : g_(n) {}
+
+  /**
+   * @brief 辺を追加し，その番号を返す．max_flowの後に追加してもよい．
+   */
+  int add_edge(int from, int to, T cap) { return g_.add_edge(from, to, cap); }
+
+  /**
+   * @brief 辺idの容量にcapを加える．max_flowの後でもよく，次のmax_flowは現在のフローから続けて流す．
+   */
+  void increase_capacity(int id, T cap) { g_.add_capacity(id, cap); }
+
+  /**
+   * @brief sourceからsinkへ，現在のフローに加えて流せるだけ流し，その量を返す．\f$O(N^2 M)\f$
+   *
+   * @param limit 流す量の上限
+   */
+  T max_flow(int source, int sink, T limit = std::numeric_limits<T>::max()) {
+    g_.build();
+    const int n = g_.size();
+    level_.resize(n);
+    iter_.resize(n);
+    queue_.resize(n);
+    T total = 0;
+    while (total < limit && bfs_(source, sink)) {
+      for (int v = 0; v < n; ++v) iter_[v] = g_.begin(v);
+      T f = blocking_flow_(source, sink, limit - total);
+      if (f == 0) break;
+      total += f;
+    }
+    return total;
+  }
+
+  typename ResidualGraph<T>::Edge get_edge(int id) const { return g_.get_edge(id); }
+
+  std::vector<std::vector<std::pair<int, T>>> get_flow() const { return g_.get_flow(); }
+
+  const ResidualGraph<T> &graph() const { return g_; }
+  ResidualGraph<T> &graph() { return g_; }
+
+  /**
+   * @brief 最小カットを，残余グラフでsourceから到達できる頂点集合として返す．O(N + M)
+   * @details sourceからの最大フローを流した後に呼ぶ．返す配列は次のmin_cutの呼び出しまで有効．
+   */
+  const std::vector<char> &min_cut(int source) {
+    g_.build();
+    g_.reachable_from(source, cut_, queue_);
+    return cut_;
+  }
+
+private:
+  ResidualGraph<T> g_;
+  // level_[v]は残余グラフでのvからsinkまでの距離．到達できなければ-1
+  std::vector<int> level_;
+  // iter_[v]は頂点vで次に調べる弧
+  std::vector<int> iter_;
+  std::vector<int> queue_;
+  std::vector<int> path_;
+  std::vector<char> cut_;
+
+  // sinkから逆向きにBFSする．sourceに到達したら打ち切る
+  bool bfs_(int source, int sink) {
+    std::fill(level_.begin(), level_.end(), -1);
+    int head = 0, tail = 0;
+    level_[sink] = 0;
+    queue_[tail++] = sink;
+    while (head < tail) {
+      int v = queue_[head++];
+      for (int i = g_.begin(v); i < g_.end(v); ++i) {
+        const auto &a = g_.arc(i);
+        if (level_[a.to] != -1 || g_.arc(a.rev).cap == 0) continue;
+        level_[a.to] = level_[v] + 1;
+        if (a.to == source) return true;
+        queue_[tail++] = a.to;
+      }
+    }
+    return false;
+  }
+
+  // 距離が1ずつ減る辺のみを使って，増加路がなくなるまで流す
+  T blocking_flow_(int source, int sink, T limit) {
+    T total = 0;
+    path_.clear();
+    int v = source;
+    while (total < limit) {
+      if (v == sink) {
+        T f = limit - total;
+        for (int i : path_) f = std::min(f, g_.arc(i).cap);
+        for (int i : path_) {
+          g_.arc(i).cap -= f;
+          g_.arc(g_.arc(i).rev).cap += f;
+        }
+        total += f;
+        // 飽和した最初の弧の始点まで戻る
+        std::size_t k = 0;
+        while (k < path_.size() && g_.arc(path_[k]).cap > 0) ++k;
+        path_.resize(k);
+        v = k == 0 ? source : g_.arc(path_[k - 1]).to;
+        continue;
+      }
+      int &i = iter_[v];
+      for (; i < g_.end(v); ++i) {
+        const auto &a = g_.arc(i);
+        if (a.cap > 0 && level_[a.to] == level_[v] - 1) break;
+      }
+      if (i < g_.end(v)) {
+        path_.push_back(i);
+        v = g_.arc(i).to;
+      } else {
+        // vからはもう流せない
+        level_[v] = -1;
+        if (path_.empty()) break;
+        v = g_.tail(path_.back());
+        path_.pop_back();
+        ++iter_[v];
+      }
+    }
+    return total;
+  }
+}; // class Dinic
+
+template <typename T>
+class HLPP {
+public:
+  explicit HLPP(int n) : g_(n) {}
+
+  int add_edge(int from, int to, T cap) { return g_.add_edge(from, to, cap); }
+
+  void increase_capacity(int id, T cap) { g_.add_capacity(id, cap); }
+
+  /**
+   * @brief sourceからsinkへ，現在のフローに加えて流せるだけ流し，その量を返す．\f$O(N^2 \sqrt M)\f$
+   */
+  T max_flow(int source, int sink) {
+    g_.build();
+    n_ = g_.size();
+    source_ = source;
+    sink_ = sink;
+    height_.assign(n_, 0);
+    excess_.assign(n_, 0);
+    current_.resize(n_);
+    active_.assign(2 * n_ + 1, std::vector<int>());
+    list_head_.assign(n_ + 1, -1);
+    list_next_.resize(n_);
+    list_prev_.resize(n_);
+
+    for (int i = g_.begin(source_); i < g_.end(source_); ++i) {
+      auto &a = g_.arc(i);
+      if (a.cap == 0) continue;
+      excess_[a.to] += a.cap;
+      g_.arc(a.rev).cap += a.cap;
+      a.cap = 0;
+    }
+
+    // 第1段階: sinkに到達できる頂点の余剰をsinkに流す
+    global_relabel_();
+    run_(true);
+    T value = excess_[sink_];
+
+    // 第2段階: 残った余剰をsourceに戻す
+    return_excess_();
+    run_(false);
+    return value;
+  }
+
+  typename ResidualGraph<T>::Edge get_edge(int id) const { return g_.get_edge(id); }
+
+  std::vector<std::vector<std::pair<int, T>>> get_flow() const { return g_.get_flow(); }
+
+  const ResidualGraph<T> &graph() const { return g_; }
+
+private:
+  ResidualGraph<T> g_;
+  int n_ = 0, source_ = -1, sink_ = -1;
+  std::vector<int> height_;
+  std::vector<T> excess_;
+  // current_[v]は頂点vで次に調べる弧
+  std::vector<int> current_;
+  // active_[h]は高さhで余剰を持つ頂点．高さが変わった頂点が残っていることがある
+  std::vector<std::vector<int>> active_;
+  int highest_ = -1;
+  // 第1段階で，高さがn_未満の頂点を高さ毎に持つ双方向連結リスト．gap heuristicに使う
+  std::vector<int> list_head_, list_next_, list_prev_;
+  int list_max_ = -1;
+  // 前回のglobal relabel以降の再ラベルで調べた弧の数
+  long long work_ = 0;
+
+  void list_insert_(int v) {
+    int h = height_[v];
+    list_prev_[v] = -1;
+    list_next_[v] = list_head_[h];
+    if (list_head_[h] != -1) list_prev_[list_head_[h]] = v;
+    list_head_[h] = v;
+    list_max_ = std::max(list_max_, h);
+  }
+
+  void list_erase_(int v) {
+    int h = height_[v];
+    if (list_prev_[v] != -1) list_next_[list_prev_[v]] = list_next_[v];
+    else list_head_[h] = list_next_[v];
+    if (list_next_[v] != -1) list_prev_[list_next_[v]] = list_prev_[v];
+  }
+
+  void activate_(int v) {
+    active_[height_[v]].push_back(v);
+    highest_ = std::max(highest_, height_[v]);
+  }
+
+  // 残余グラフでsinkへの距離を高さとする．到達できない頂点の高さはn_
+  void global_relabel_() {
+    std::fill(height_.begin(), height_.end(), n_);
+    std::fill(list_head_.begin(), list_head_.end(), -1);
+    for (auto &bucket : active_) bucket.clear();
+    highest_ = list_max_ = -1;
+    work_ = 0;
+    std::vector<int> queue(1, sink_);
+    height_[sink_] = 0;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+      int v = queue[head];
+      for (int i = g_.begin(v); i < g_.end(v); ++i) {
+        const auto &a = g_.arc(i);
+        if (height_[a.to] != n_ || a.to == source_ || g_.arc(a.rev).cap == 0) continue;
+        height_[a.to] = height_[v] + 1;
+        queue.push_back(a.to);
+      }
+    }
+    for (int v = 0; v < n_; ++v) {
+      current_[v] = g_.begin(v);
+      if (height_[v] < n_) list_insert_(v);
+      if (excess_[v] > 0 && v != sink_ && v != source_ && height_[v] < n_) activate_(v);
+    }
+  }
+
+  // 頂点の高さを，残余グラフでのsourceへの距離 + n_とする．sourceに到達できない頂点は2n_で，余剰が流れ込まない
+  void return_excess_() {
+    std::fill(height_.begin(), height_.end(), 2 * n_);
+    std::vector<int> queue(1, source_);
+    height_[source_] = n_;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+      int v = queue[head];
+      for (int i = g_.begin(v); i < g_.end(v); ++i) {
+        const auto &a = g_.arc(i);
+        if (height_[a.to] != 2 * n_ || g_.arc(a.rev).cap == 0) continue;
+        height_[a.to] = height_[v] + 1;
+        queue.push_back(a.to);
+      }
+    }
+    for (auto &bucket : active_) bucket.clear();
+    highest_ = -1;
+    for (int v = 0; v < n_; ++v) {
+      current_[v] = g_.begin(v);
+      if (excess_[v] > 0 && v != sink_ && v != source_) activate_(v);
+    }
+  }
+
+  void run_(bool first_phase) {
+    const long long relabel_limit = 6LL * n_ + 2LL * g_.edge_count();
+    while (true) {
+      while (highest_ >= 0 && active_[highest_].empty()) --highest_;
+      if (highest_ < 0) break;
+      int v = active_[highest_].back();
+      active_[highest_].pop_back();
+      if (height_[v] != highest_ || excess_[v] == 0) continue;
+      discharge_(v, first_phase);
+      if (first_phase && work_ > relabel_limit) global_relabel_();
+    }
+  }
+
+  void discharge_(int v, bool first_phase) {
+    while (excess_[v] > 0) {
+      if (current_[v] == g_.end(v)) {
+        relabel_(v, first_phase);
+        if (first_phase && height_[v] >= n_) return;
+        continue;
+      }
+      auto &a = g_.arc(current_[v]);
+      if (a.cap > 0 && height_[v] == height_[a.to] + 1) {
+        T d = std::min(excess_[v], a.cap);
+        a.cap -= d;
+        g_.arc(a.rev).cap += d;
+        excess_[v] -= d;
+        if (excess_[a.to] == 0 && a.to != sink_ && a.to != source_) activate_(a.to);
+        excess_[a.to] += d;
+      } else {
+        ++current_[v];
+      }
+    }
+  }
+
+  void relabel_(int v, bool first_phase) {
+    int h = 2 * n_;
+    for (int i = g_.begin(v); i < g_.end(v); ++i) {
+      const auto &a = g_.arc(i);
+      if (a.cap > 0) h = std::min(h, height_[a.to] + 1);
+    }
+    work_ += g_.end(v) - g_.begin(v);
+    current_[v] = g_.begin(v);
+    if (!first_phase) {
+      height_[v] = h;
+      return;
+    }
+
+    int old = height_[v];
+    list_erase_(v);
+    if (list_head_[old] == -1) {
+      // 高さoldの頂点がなくなったので，それより高い頂点はsinkに到達できない
+      for (int k = old + 1; k <= list_max_; ++k) {
+        for (int u = list_head_[k]; u != -1; u = list_next_[u]) height_[u] = n_;
+        list_head_[k] = -1;
+      }
+      list_max_ = old - 1;
+      height_[v] = n_;
+      return;
+    }
+    height_[v] = std::min(h, n_);
+    if (height_[v] < n_) list_insert_(v);
+  }
+}; // class HLPP
@@ -0,0 +1,267 @@
+#pragma once
+/**
+ * @file min_cost_flow.hpp
+ * @brief 最小費用流に関するコード
+ * @details
+ * * MinCostFlow
+ *   * 残余グラフはmax_flow.hppのResidualGraph(Dinicが保持する)を使い，費用は弧の位置で引く配列に持つ．
+ *   * flow, slope
+ *     * 主双対法．ポテンシャルによる被約費用の上でDijkstra法を行い，最短路に沿って流す．
+ *     * ヒープはDaryHeap(decrease-keyあり)を使う．終点が確定した時点で探索を打ち切る．
+ *     * 負の費用の辺がある場合は，最初にBellman-Ford法でポテンシャルを求める．負の閉路があってはならない．
+ *     * slopeは流量と費用の関係(区分線形な凸関数)の折れ点を返す．
+ *     * 流量をFとして\f$O(F (N + M) \log N)\f$．
+ *   * flow_cost_scaling
+ *     * Dinic法で最大フローを流してから，コストスケーリング法(ε-最適な擬フローのpush/relabel)で負閉路を解消する．
+ *     * 費用を(N + 1)倍して，ε = 1になるまでεを1 / 16ずつにする．費用の最大値をCとして
+ *       \f$O(N^2 M \log (NC))\f$．流量が大きく，主双対法の反復回数が多くなる場合に使う．
+ *     * ポテンシャルの絶対値はN^2 C程度になるので，それがCostの範囲に収まる必要がある．
+ * @example min_cost_flow_test.cpp
+ */
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "max_flow.hpp"
+#include "../dary_heap.hpp"
+
+template <typename Cap, typename Cost>
+class MinCostFlow {
+public:
+  struct Edge {
+    int from, to;
+    Cap cap, flow;
+    Cost cost;
+  };
+
+  explicit MinCostFlow(int n) : n_(n), dinic_(n), potential_(n, 0), dist_(n), prev_arc_(n), settled_(n), heap_(n) {}
+
+  /**
+   * @brief fromからtoへの容量cap，単位流量あたりの費用costの辺を追加し，その番号を返す．
+   */
+  int add_edge(int from, int to, Cap cap, Cost cost) {
+    edge_cost_.push_back(cost);
+    return dinic_.add_edge(from, to, cap);
+  }
+
+  /**
+   * @brief sourceからsinkへ，現在のフローに加えて流量limitまで最小費用で流す．
+   * @return (流した量，その費用)
+   */
+  std::pair<Cap, Cost> flow(int source, int sink, Cap limit = std::numeric_limits<Cap>::max()) {
+    return slope(source, sink, limit).back();
+  }
+
+  /**
+   * @brief flowと同じく流し，流量xに対する最小費用の折れ線の折れ点(x，費用)を流量の昇順に返す．
+   * @details 最初の要素は(0, 0)，最後の要素はflowの返り値．隣り合う線分の傾きは異なる．
+   */
+  std::vector<std::pair<Cap, Cost>> slope(int source, int sink, Cap limit = std::numeric_limits<Cap>::max()) {
+    build_();
+    init_potential_();
+    ResidualGraph<Cap> &g = dinic_.graph();
+    std::vector<std::pair<Cap, Cost>> ret(1, std::make_pair(Cap(0), Cost(0)));
+    Cap flow = 0;
+    Cost cost = 0, prev_unit = 0;
+    while (flow < limit && dijkstra_(source, sink)) {
+      Cap f = limit - flow;
+      for (int v = sink; v != source; v = g.tail(prev_arc_[v])) f = std::min(f, g.arc(prev_arc_[v]).cap);
+      for (int v = sink; v != source; v = g.tail(prev_arc_[v])) {
+        auto &a = g.arc(prev_arc_[v]);
+        a.cap -= f;
+        g.arc(a.rev).cap += f;
+      }
+      // 最短路の費用はポテンシャルの差に等しい
+      Cost unit = potential_[sink] - potential_[source];
+      flow += f;
+      cost += f * unit;
+      if (ret.size() >= 2 && unit == prev_unit) ret.pop_back();
+      ret.emplace_back(flow, cost);
+      prev_unit = unit;
+    }
+    return ret;
+  }
+
+  /**
+   * @brief sourceからsinkへ流せるだけ流し，コストスケーリング法でその流量での最小費用にする．
+   * @return (流した量，費用の増加量)
+   */
+  std::pair<Cap, Cost> flow_cost_scaling(int source, int sink) {
+    build_();
+    Cost before = total_cost_();
+    Cap flow = dinic_.max_flow(source, sink);
+    cost_scaling_();
+    return std::make_pair(flow, total_cost_() - before);
+  }
+
+  Edge get_edge(int id) const {
+    auto e = dinic_.get_edge(id);
+    return Edge{e.from, e.to, e.cap, e.flow, edge_cost_[id]};
+  }
+
+  std::vector<std::vector<std::pair<int, Cap>>> get_flow() const { return dinic_.get_flow(); }
+
+private:
+  // コストスケーリングでεを何分の1ずつにするか
+  static constexpr int SCALING_FACTOR_ = 16;
+  static constexpr Cost INF_ = std::numeric_limits<Cost>::max();
+
+  int n_;
+  // 残余グラフを保持する．コストスケーリングの最初の最大フローにも使う
+  Dinic<Cap> dinic_;
+  std::vector<Cost> edge_cost_;
+  // arc_cost_[i]は弧iの費用．逆辺の費用は元の辺の費用の-1倍
+  std::vector<Cost> arc_cost_;
+  std::vector<Cost> potential_, dist_;
+  std::vector<int> prev_arc_;
+  std::vector<char> settled_;
+  DaryHeap<Cost> heap_;
+
+  void build_() {
+    ResidualGraph<Cap> &g = dinic_.graph();
+    if (g.is_built() && arc_cost_.size() == 2 * edge_cost_.size()) return;
+    g.build();
+    arc_cost_.resize(2 * edge_cost_.size());
+    for (int id = 0; id < int(edge_cost_.size()); ++id) {
+      int i = g.arc_of(id);
+      arc_cost_[i] = edge_cost_[id];
+      arc_cost_[g.arc(i).rev] = -edge_cost_[id];
+    }
+  }
+
+  Cost reduced_cost_(int i, int from, int to) const {
+    return arc_cost_[i] + potential_[from] - potential_[to];
+  }
+
+  // 被約費用が負の残余辺があれば，Bellman-Ford法でポテンシャルを求め直す
+  void init_potential_() {
+    const ResidualGraph<Cap> &g = dinic_.graph();
+    bool valid = true;
+    for (int v = 0; v < n_ && valid; ++v) {
+      for (int i = g.begin(v); i < g.end(v); ++i) {
+        if (g.arc(i).cap > 0 && reduced_cost_(i, v, g.arc(i).to) < 0) {
+          valid = false;
+          break;
+        }
+      }
+    }
+    if (valid) return;
+
+    // 全頂点を距離0の始点とする
+    std::fill(potential_.begin(), potential_.end(), 0);
+    std::vector<int> queue(n_);
+    std::vector<char> in_queue(n_, true);
+    for (int v = 0; v < n_; ++v) queue[v] = v;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+      int v = queue[head];
+      in_queue[v] = false;
+      for (int i = g.begin(v); i < g.end(v); ++i) {
+        const auto &a = g.arc(i);
+        if (a.cap == 0 || potential_[v] + arc_cost_[i] >= potential_[a.to]) continue;
+        potential_[a.to] = potential_[v] + arc_cost_[i];
+        if (!in_queue[a.to]) {
+          in_queue[a.to] = true;
+          queue.push_back(a.to);
+        }
+      }
+    }
+  }
+
+  // 被約費用での最短路を求め，ポテンシャルを更新する．sinkに到達できなければfalse
+  bool dijkstra_(int source, int sink) {
+    const ResidualGraph<Cap> &g = dinic_.graph();
+    std::fill(dist_.begin(), dist_.end(), INF_);
+    std::fill(settled_.begin(), settled_.end(), false);
+    heap_.clear();
+    dist_[source] = 0;
+    heap_.push(0, source);
+    while (!heap_.empty()) {
+      auto [d, v] = heap_.pop();
+      settled_[v] = true;
+      if (v == sink) break;
+      for (int i = g.begin(v); i < g.end(v); ++i) {
+        const auto &a = g.arc(i);
+        if (a.cap == 0 || settled_[a.to]) continue;
+        Cost nd = d + reduced_cost_(i, v, a.to);
+        if (nd < dist_[a.to]) {
+          dist_[a.to] = nd;
+          prev_arc_[a.to] = i;
+          heap_.push(nd, a.to);
+        }
+      }
+    }
+    if (!settled_[sink]) return false;
+    // 確定していない頂点の距離はsinkまでの距離以上なので，sinkまでの距離で打ち切る
+    for (int v = 0; v < n_; ++v) potential_[v] += std::min(dist_[v], dist_[sink]);
+    return true;
+  }
+
+  Cost total_cost_() const {
+    const ResidualGraph<Cap> &g = dinic_.graph();
+    Cost ret = 0;
+    for (int id = 0; id < int(edge_cost_.size()); ++id) {
+      ret += g.arc(g.arc(g.arc_of(id)).rev).cap * edge_cost_[id];
+    }
+    return ret;
+  }
+
+  // 現在のフローを，流量を変えずに最小費用にする
+  void cost_scaling_() {
+    ResidualGraph<Cap> &g = dinic_.graph();
+    const Cost scale = n_ + 1;
+    std::vector<Cost> cost(arc_cost_.size()), price(n_, 0);
+    Cost eps = 0;
+    for (std::size_t i = 0; i < cost.size(); ++i) {
+      cost[i] = arc_cost_[i] * scale;
+      eps = std::max(eps, cost[i] < 0 ? -cost[i] : cost[i]);
+    }
+    std::vector<Cap> excess(n_, 0);
+    std::vector<int> current(n_), active;
+    auto push = [&](int v, int i, Cap d) {
+      auto &a = g.arc(i);
+      a.cap -= d;
+      g.arc(a.rev).cap += d;
+      excess[v] -= d;
+      if (excess[a.to] <= 0 && excess[a.to] + d > 0) active.push_back(a.to);
+      excess[a.to] += d;
+    };
+
+    while (eps > 1) {
+      eps = std::max<Cost>(1, eps / SCALING_FACTOR_);
+      // 被約費用が負の残余辺を全て飽和させると0-最適な擬フローになる
+      for (int v = 0; v < n_; ++v) {
+        for (int i = g.begin(v); i < g.end(v); ++i) {
+          const auto &a = g.arc(i);
+          if (a.cap > 0 && cost[i] + price[v] - price[a.to] < 0) push(v, i, a.cap);
+        }
+      }
+      for (int v = 0; v < n_; ++v) current[v] = g.begin(v);
+
+      // 余剰を持つ頂点から被約費用が負の辺に流し，流せなければ価格を下げる
+      while (!active.empty()) {
+        int v = active.back();
+        active.pop_back();
+        while (excess[v] > 0) {
+          if (current[v] == g.end(v)) {
+            Cost best = -INF_;
+            for (int i = g.begin(v); i < g.end(v); ++i) {
+              if (g.arc(i).cap > 0) best = std::max(best, price[g.arc(i).to] - cost[i]);
+            }
+            price[v] = best - eps;
+            current[v] = g.begin(v);
+            continue;
+          }
+          int i = current[v];
+          const auto &a = g.arc(i);
+          if (a.cap > 0 && cost[i] + price[v] - price[a.to] < 0) {
+            push(v, i, std::min(excess[v], a.cap));
+          } else {
+            ++current[v];
+          }
+        }
+      }
+    }
+  }
+};
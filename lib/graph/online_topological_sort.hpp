@@ -0,0 +1,148 @@
+#pragma once
+/**
+ * @file online_topological_sort.hpp
+ * @brief 辺の追加に対してトポロジカル順序を維持する(Pearce–Kelly法)
+ * @details
+ * * 各頂点の位置pos[v]と，位置iにある頂点order[i]を持つ．
+ * * 辺x → yを追加したとき，pos[x] < pos[y]なら何もしない．そうでなければ，
+ *   * yから位置pos[x]以下の頂点だけを通って前向きに探索する(δF)．xに到達したら閉路ができる．
+ *   * xから位置pos[y]より大きい頂点だけを通って後ろ向きに探索する(δB)．
+ *   * δBとδFの頂点が使っていた位置を昇順に集め，δBの頂点(元の順)，δFの頂点(元の順)の順に割り当て直す．
+ *   * 位置が[pos[y], pos[x]]の範囲の外にある頂点は動かさない．探索と並べ替えは影響を受けた頂点の数と
+ *     その辺の数に比例する時間で済む．
+ * * 閉路ができた後は順序を維持しない．is_sortable()はfalseを返す．
+ * * グラフは辺が追加されるので，隣接リスト(vectorのvector)で持つ．
+ * @example online_topological_sort_test.cpp
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+class OnlineTopologicalSort {
+public:
+  /**
+   * @brief OnlineTopologicalSortクラスのコンストラクタ．最初の順序は0, 1, ..., n - 1
+   *
+   * @param n 頂点数
+   */
+  explicit OnlineTopologicalSort(int n = 0) : out_(n), in_(n), pos_(n), order_(n), visited_(n, 0) {
+    for (int v = 0; v < n; ++v) pos_[v] = order_[v] = v;
+  }
+
+  /**
+   * @brief 頂点を追加し，その番号を返す．新しい頂点は順序の最後に置く
+   */
+  int add_vertex() {
+    const int v = size();
+    out_.emplace_back();
+    in_.emplace_back();
+    pos_.push_back(v);
+    order_.push_back(v);
+    visited_.push_back(0);
+    return v;
+  }
+
+  /**
+   * @brief 有向辺fromからtoを追加し，順序を更新する．
+   *
+   * @return 追加後もトポロジカルソート可能かどうか
+   */
+  bool add_edge(int from, int to) {
+    assert(0 <= from && from < size() && 0 <= to && to < size());
+    out_[from].push_back(to);
+    in_[to].push_back(from);
+    if (!is_sortable_) return false;
+
+    const int lb = pos_[to], ub = pos_[from];
+    if (lb < ub || from == to) {
+      if (from == to || !forward_(to, ub)) {
+        is_sortable_ = false;
+        return false;
+      }
+      backward_(from, lb);
+      reorder_();
+    }
+    return true;
+  }
+
+  int size() const { return static_cast<int>(pos_.size()); }
+
+  /**
+   * @brief トポロジカルソート可能性の判定
+   */
+  bool is_sortable() const { return is_sortable_; }
+
+  /**
+   * @brief トポロジカルソートした頂点列を返す．ソート可能でなければ空列
+   */
+  std::vector<int> sorted() const {
+    if (!is_sortable_) return std::vector<int>();
+    return order_;
+  }
+
+  /**
+   * @brief 頂点vの順序での位置を返す．ソート可能なときのみ有効
+   */
+  int position(int v) const { return pos_[v]; }
+
+private:
+  std::vector<std::vector<int>> out_, in_;
+  std::vector<int> pos_, order_;
+  bool is_sortable_ = true;
+  // visited_[v] == stamp_なら今回の探索で訪れた
+  std::vector<int> visited_;
+  int stamp_ = 0;
+  std::vector<int> forward_set_, backward_set_, stack_, positions_;
+
+  // toから位置ub以下の頂点を前向きに探索する．位置ubの頂点(追加した辺の始点)に到達したらfalse
+  bool forward_(int to, int ub) {
+    ++stamp_;
+    forward_set_.clear();
+    stack_.assign(1, to);
+    visited_[to] = stamp_;
+    while (!stack_.empty()) {
+      const int v = stack_.back();
+      stack_.pop_back();
+      forward_set_.push_back(v);
+      for (int w : out_[v]) {
+        if (pos_[w] == ub) return false;
+        if (visited_[w] == stamp_ || pos_[w] > ub) continue;
+        visited_[w] = stamp_;
+        stack_.push_back(w);
+      }
+    }
+    return true;
+  }
+
+  // fromから位置lbより大きい頂点を後ろ向きに探索する
+  void backward_(int from, int lb) {
+    backward_set_.clear();
+    stack_.assign(1, from);
+    visited_[from] = stamp_;
+    while (!stack_.empty()) {
+      const int v = stack_.back();
+      stack_.pop_back();
+      backward_set_.push_back(v);
+      for (int w : in_[v]) {
+        if (visited_[w] == stamp_ || pos_[w] <= lb) continue;
+        visited_[w] = stamp_;
+        stack_.push_back(w);
+      }
+    }
+  }
+
+  // δBとδFが使っていた位置に，δB，δFの順で頂点を置き直す
+  void reorder_() {
+    auto by_pos = [this](int u, int v) { return pos_[u] < pos_[v]; };
+    std::sort(backward_set_.begin(), backward_set_.end(), by_pos);
+    std::sort(forward_set_.begin(), forward_set_.end(), by_pos);
+    positions_.clear();
+    for (int v : backward_set_) positions_.push_back(pos_[v]);
+    for (int v : forward_set_) positions_.push_back(pos_[v]);
+    std::inplace_merge(positions_.begin(), positions_.begin() + backward_set_.size(), positions_.end());
+    std::size_t i = 0;
+    for (int v : backward_set_) order_[pos_[v] = positions_[i++]] = v;
+    for (int v : forward_set_) order_[pos_[v] = positions_[i++]] = v;
+  }
+};
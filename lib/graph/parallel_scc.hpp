@@ -0,0 +1,343 @@
+#pragma once
+/**
+ * @file parallel_scc.hpp
+ * @brief 並列な強連結成分分解
+ * @details
+ * * 次の3段階で強連結成分を求める．
+ *   1. trim: 残っている頂点の中で入次数か出次数が0の頂点は，それだけで1つの成分になるので取り除く．
+ *      取り除いた頂点の隣接頂点の次数をatomicに減らし，0になった頂点を次の段で取り除く．
+ *   2. forward-backward: 大きいタスク(同じ色の頂点集合)では，ピボット(入次数と出次数の積が最大の頂点)から
+ *      タスク内で前向き・後ろ向きの幅優先探索を行い，両方で到達した頂点をピボットの成分とする．
+ *      残りは前向きのみ・後ろ向きのみ・どちらでもない，の3つのタスクに分かれる．幅優先探索は各段を並列に処理する．
+ *   3. 小さいタスクや，直前のforward-backwardで小さい成分しか見つからなかったタスクは，
+ *      タスク内に制限したTarjan法で解く．タスクはスレッドに動的に割り当てる．
+ * * 各頂点に[0, N)の位置を割り当てておき，成分を位置の順に並べたものがトポロジカル順になるようにする．
+ *   * trimで取り除いた入次数0の頂点は前から，出次数0の頂点は後ろから詰める．
+ *   * forward-backwardでは(後ろ向きのみ，ピボットの成分，どちらでもない，前向きのみ)の順に区間を分ける．
+ *     どの2つの間にも，後ろの区間から前の区間への辺はない．
+ *   * Tarjan法は成分をトポロジカル順の逆に見つけるので，区間の後ろから詰める．
+ * * 逆向きのグラフを作るのでグラフ2つ分のメモリを使う．
+ * * 結果のインターフェースはSCCと同じ．
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "scc.hpp"
+
+class ParallelSCC {
+public:
+  /**
+   * @brief ParallelSCCクラスのコンストラクタ．強連結成分を計算する．
+   *
+   * @param graph CSR形式の有向グラフ
+   * @param n_threads 使うスレッド数
+   */
+  explicit ParallelSCC(const CSRGraph<> &graph, int n_threads = 1)
+    : n_(graph.size()), n_threads_(std::max(n_threads, 1)), comp_(graph.size())
+  {
+    const CSRGraph<> rev = graph.reversed();
+    solve_(graph, rev);
+  }
+
+  /**
+   * @brief 各頂点の強連結成分番号を返す．成分番号はトポロジカル順
+   */
+  const std::vector<int> &comp() const { return comp_; }
+
+  int comp_count() const { return n_comp_; }
+
+  bool is_same(const int u, const int v) const { return comp_[u] == comp_[v]; }
+
+  int comp_size(const int u) const { return siz_[comp_[u]]; }
+
+  /**
+   * @brief 強連結成分の配列をトポロジカル順に返す
+   */
+  std::vector<std::vector<int>> scc() const {
+    std::vector<std::vector<int>> ret(n_comp_);
+    for (int i = 0; i < n_comp_; ++i) ret[i].reserve(siz_[i]);
+    for (int v = 0; v < n_; ++v) ret[comp_[v]].push_back(v);
+    return ret;
+  }
+
+  /**
+   * @brief 強連結成分を縮約したDAGをCSR形式で返す．graphはコンストラクタに渡したもの
+   */
+  CSRGraph<> condensation(const CSRGraph<> &graph) const {
+    return scc_internal::condensation(graph, comp_, n_comp_);
+  }
+
+private:
+  // これより小さいタスクはforward-backwardを行わずTarjan法で解く
+  static constexpr int SEQUENTIAL_THRESHOLD_ = 1 << 14;
+
+  // 同じ色の頂点集合．成分の位置は[lo, lo + vertices.size())
+  struct Task {
+    int color, lo;
+    std::vector<int> vertices;
+    // forward-backwardを行うか
+    bool split;
+  };
+
+  struct Frame {
+    int u, low;
+    const int *it, *end;
+  };
+
+  int n_, n_threads_;
+  int n_comp_ = 0;
+  std::vector<int> comp_, siz_;
+
+  // 以下はsolve_の間だけ使う
+  // color_[v]は頂点vが属するタスクの色．成分が確定していれば-1
+  std::vector<int> color_;
+  // key_[v]は頂点vが属する成分の位置．Tarjan法の途中では，訪れた順番kを-2 - kとして持つ．未確定なら-1
+  std::vector<int> key_;
+  // 幅優先探索で到達した頂点に，タスクの色を書き込む
+  std::unique_ptr<std::atomic<int>[]> forward_, backward_;
+  int n_colors_ = 0;
+
+  void solve_(const CSRGraph<> &g, const CSRGraph<> &rev) {
+    color_.assign(n_, -1);
+    key_.assign(n_, -1);
+    forward_.reset(new std::atomic<int>[n_]);
+    backward_.reset(new std::atomic<int>[n_]);
+    parallel_for_(n_, [&](int, std::size_t first, std::size_t last) {
+      for (std::size_t v = first; v < last; ++v) {
+        forward_[v].store(-1, std::memory_order_relaxed);
+        backward_[v].store(-1, std::memory_order_relaxed);
+      }
+    });
+
+    std::vector<Task> large, small;
+    auto push_task = [&](Task &&task) {
+      if (task.vertices.empty()) return;
+      for (int v : task.vertices) color_[v] = task.color;
+      if (task.split && int(task.vertices.size()) >= SEQUENTIAL_THRESHOLD_) {
+        large.push_back(std::move(task));
+      } else {
+        small.push_back(std::move(task));
+      }
+    };
+
+    int lo = 0;
+    std::vector<int> rest = trim_(g, rev, lo);
+    push_task(Task{n_colors_++, lo, std::move(rest), true});
+
+    while (!large.empty()) {
+      Task task = std::move(large.back());
+      large.pop_back();
+      std::vector<int> parts[4];
+      split_(g, rev, task, parts);
+      // 後ろ向きのみ，ピボットの成分，どちらでもない，前向きのみの順に位置を割り当てる
+      int pos = task.lo;
+      for (int k = 0; k < 4; ++k) {
+        const int size = parts[k].size();
+        if (k == 1) {
+          for (int v : parts[k]) {
+            key_[v] = pos;
+            color_[v] = -1;
+          }
+        } else {
+          // ピボットの成分が小さければ，以降はTarjan法で解く
+          push_task(Task{n_colors_++, pos, std::move(parts[k]), parts[1].size() >= SEQUENTIAL_THRESHOLD_});
+        }
+        pos += size;
+      }
+    }
+
+    // 大きいタスクから順にスレッドに割り当てる
+    std::sort(small.begin(), small.end(), [](const Task &a, const Task &b) { return a.vertices.size() > b.vertices.size(); });
+    std::atomic<std::size_t> next(0);
+    auto worker = [&] {
+      std::vector<int> stack;
+      std::vector<Frame> call;
+      for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < small.size();) {
+        tarjan_(g, small[i], stack, call);
+      }
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < std::min<int>(n_threads_, small.size()); ++t) threads.emplace_back(worker);
+    worker();
+    for (std::thread &th : threads) th.join();
+
+    // 位置の順に成分番号を振る
+    std::vector<int> &rank = comp_;
+    std::fill(rank.begin(), rank.end(), 0);
+    for (int v = 0; v < n_; ++v) rank[key_[v]] = 1;
+    n_comp_ = 0;
+    for (int p = 0; p < n_; ++p) rank[p] = rank[p] ? n_comp_++ : -1;
+    for (int v = 0; v < n_; ++v) key_[v] = rank[key_[v]];
+    comp_.swap(key_);
+    siz_.assign(n_comp_, 0);
+    for (int v = 0; v < n_; ++v) ++siz_[comp_[v]];
+
+    std::vector<int>().swap(color_);
+    std::vector<int>().swap(key_);
+    forward_.reset();
+    backward_.reset();
+  }
+
+  // 入次数か出次数が0の頂点を繰り返し取り除き，残った頂点を返す．loには残った頂点の位置の始まりを入れる
+  std::vector<int> trim_(const CSRGraph<> &g, const CSRGraph<> &rev, int &lo) {
+    std::unique_ptr<std::atomic<int>[]> in_degree(new std::atomic<int>[n_]), out_degree(new std::atomic<int>[n_]);
+    std::unique_ptr<std::atomic<char>[]> removed(new std::atomic<char>[n_]);
+    std::atomic<int> front(0), back(n_);
+    // 取り除いた頂点．入次数0の頂点vはv，出次数0の頂点vは~vとして持つ
+    std::vector<int> frontier;
+    std::vector<std::vector<int>> next(n_threads_);
+
+    // 入次数0なら前から，出次数0なら後ろから位置を割り当てる
+    auto remove = [&](int v, bool source, std::vector<int> &out) {
+      if (removed[v].exchange(1, std::memory_order_relaxed)) return;
+      key_[v] = source ? front.fetch_add(1, std::memory_order_relaxed) : back.fetch_sub(1, std::memory_order_relaxed) - 1;
+      out.push_back(source ? v : ~v);
+    };
+    auto gather = [&] {
+      frontier.clear();
+      for (auto &out : next) {
+        frontier.insert(frontier.end(), out.begin(), out.end());
+        out.clear();
+      }
+    };
+
+    parallel_for_(n_, [&](int t, std::size_t first, std::size_t last) {
+      for (std::size_t v = first; v < last; ++v) {
+        in_degree[v].store(rev.out_degree(v), std::memory_order_relaxed);
+        out_degree[v].store(g.out_degree(v), std::memory_order_relaxed);
+        removed[v].store(0, std::memory_order_relaxed);
+        if (rev.out_degree(v) == 0 || g.out_degree(v) == 0) remove(v, rev.out_degree(v) == 0, next[t]);
+      }
+    });
+    gather();
+
+    while (!frontier.empty()) {
+      parallel_for_(frontier.size(), [&](int t, std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+          if (frontier[i] >= 0) {
+            for (int w : g.adj(frontier[i])) {
+              if (in_degree[w].fetch_sub(1, std::memory_order_relaxed) == 1) remove(w, true, next[t]);
+            }
+          } else {
+            for (int w : rev.adj(~frontier[i])) {
+              if (out_degree[w].fetch_sub(1, std::memory_order_relaxed) == 1) remove(w, false, next[t]);
+            }
+          }
+        }
+      });
+      gather();
+    }
+
+    std::vector<int> rest;
+    rest.reserve(back - front);
+    for (int v = 0; v < n_; ++v) {
+      if (!removed[v].load(std::memory_order_relaxed)) rest.push_back(v);
+    }
+    lo = front;
+    return rest;
+  }
+
+  // タスクをピボットからのforward-backwardで，(後ろ向きのみ，両方，どちらでもない，前向きのみ)に分ける
+  void split_(const CSRGraph<> &g, const CSRGraph<> &rev, const Task &task, std::vector<int> (&parts)[4]) {
+    int pivot = task.vertices[0];
+    long long best = -1;
+    for (int v : task.vertices) {
+      long long score = static_cast<long long>(g.out_degree(v)) * rev.out_degree(v);
+      if (score > best) {
+        best = score;
+        pivot = v;
+      }
+    }
+    bfs_(g, forward_.get(), task.color, pivot);
+    bfs_(rev, backward_.get(), task.color, pivot);
+    for (int v : task.vertices) {
+      const bool f = forward_[v].load(std::memory_order_relaxed) == task.color;
+      const bool b = backward_[v].load(std::memory_order_relaxed) == task.color;
+      parts[f ? (b ? 1 : 3) : (b ? 0 : 2)].push_back(v);
+    }
+  }
+
+  // 色colorの頂点だけを通ってsourceから到達できる頂点のmarkにcolorを書き込む．各段の頂点を並列に処理する
+  void bfs_(const CSRGraph<> &g, std::atomic<int> *mark, int color, int source) const {
+    std::vector<int> frontier(1, source);
+    std::vector<std::vector<int>> next(n_threads_);
+    mark[source].store(color, std::memory_order_relaxed);
+    while (!frontier.empty()) {
+      parallel_for_(frontier.size(), [&](int t, std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+          for (int w : g.adj(frontier[i])) {
+            if (color_[w] != color || mark[w].load(std::memory_order_relaxed) == color) continue;
+            if (mark[w].exchange(color, std::memory_order_relaxed) != color) next[t].push_back(w);
+          }
+        }
+      });
+      frontier.clear();
+      for (auto &out : next) {
+        frontier.insert(frontier.end(), out.begin(), out.end());
+        out.clear();
+      }
+    }
+  }
+
+  // タスク内に制限したTarjan法．見つけた成分に区間の後ろから位置を割り当てる
+  void tarjan_(const CSRGraph<> &g, const Task &task, std::vector<int> &stack, std::vector<Frame> &call) {
+    const int color = task.color;
+    int hi = task.lo + task.vertices.size();
+    int k = 0;
+    auto visit = [&](int v) {
+      key_[v] = -2 - k;
+      stack.push_back(v);
+      auto adj = g.adj(v);
+      call.push_back(Frame{v, k++, adj.begin(), adj.end()});
+    };
+
+    for (int r : task.vertices) {
+      if (key_[r] != -1) continue;
+      visit(r);
+      while (!call.empty()) {
+        Frame &f = call.back();
+        if (f.it != f.end) {
+          const int v = *f.it++;
+          if (color_[v] != color) continue;
+          if (key_[v] == -1) {
+            visit(v);
+          } else if (key_[v] < -1 && -2 - key_[v] < f.low) {
+            // vはスタック上にある
+            f.low = -2 - key_[v];
+          }
+          continue;
+        }
+
+        const int u = f.u, low = f.low;
+        call.pop_back();
+        if (!call.empty() && low < call.back().low) call.back().low = low;
+        if (low != -2 - key_[u]) continue;
+        // uを根とする成分が確定した
+        std::size_t first = stack.size();
+        while (stack[--first] != u) {}
+        hi -= stack.size() - first;
+        for (std::size_t i = first; i < stack.size(); ++i) key_[stack[i]] = hi;
+        stack.resize(first);
+      }
+    }
+    assert(hi == task.lo);
+  }
+
+  // [0, count)をn_threads_個の区間に分け，fn(スレッド番号，区間の始め，区間の終わり)を並列に呼ぶ
+  void parallel_for_(std::size_t count, const std::function<void(int, std::size_t, std::size_t)> &fn) const {
+    int n_threads = std::max(1, std::min<int>(n_threads_, count / 4096 + 1));
+    std::vector<std::thread> threads;
+    for (int t = 1; t < n_threads; ++t) {
+      threads.emplace_back(fn, t, count * t / n_threads, count * (t + 1) / n_threads);
+    }
+    fn(0, 0, count / n_threads);
+    for (std::thread &th : threads) th.join();
+  }
+};
@@ -1,6 +1,12 @@
 /**
  * @file scc.hpp
  * @brief 強連結成分分解に関するコード
+ * @details
+ * * グラフはCSR形式(CSRGraph<>)で走査する．隣接リストを渡した場合はCSR形式に変換する．
+ * * Tarjan法で1回のDFSにより強連結成分を求める．DFSは再帰を使わず，各頂点で次に調べる辺の位置を覚えておくので，
+ *   パスが長いグラフでもスタックオーバーフローしない．
+ * * Tarjan法は成分をトポロジカル順の逆に見つけるので，番号を付け替えてトポロジカル順にする．
+ * * グラフは保持しない．縮約したグラフが必要な場合はcondensationに同じグラフを渡す．
  * @example scc_test.cpp
  */
 #ifndef OKINA_SCC
@@ -8,10 +14,51 @@
 
 #include <algorithm>
 #include <cassert>
-#include <map>
-#include <set>
 #include <vector>
 
+#include "csr_graph.hpp"
+
+namespace scc_internal {
+
+/**
+ * @brief 頂点vを成分comp[v]に縮約したグラフをCSR形式で返す．成分内の辺と多重辺は除く．O(N + M)
+ */
+inline CSRGraph<> condensation(const CSRGraph<> &graph, const std::vector<int> &comp, int n_comp) {
+  const int n = graph.size();
+  assert(int(comp.size()) == n);
+  std::vector<int> start(n_comp + 1, 0);
+  for (int u = 0; u < n; ++u) {
+    for (int v : graph.adj(u)) {
+      if (comp[u] != comp[v]) ++start[comp[u] + 1];
+    }
+  }
+  for (int i = 0; i < n_comp; ++i) start[i + 1] += start[i];
+  std::vector<int> to(start[n_comp]), pos(start.begin(), start.end() - 1);
+  for (int u = 0; u < n; ++u) {
+    for (int v : graph.adj(u)) {
+      if (comp[u] != comp[v]) to[pos[comp[u]]++] = comp[v];
+    }
+  }
+
+  // 各成分の辺から重複を除いて前に詰める
+  std::vector<int> last(n_comp, -1);
+  int size = 0;
+  for (int c = 0; c < n_comp; ++c) {
+    const int first = start[c];
+    start[c] = size;
+    for (int i = first; i < start[c + 1]; ++i) {
+      if (last[to[i]] == c) continue;
+      last[to[i]] = c;
+      to[size++] = to[i];
+    }
+  }
+  start[n_comp] = size;
+  to.resize(size);
+  return CSRGraph<>(std::move(start), std::move(to));
+}
+
+} // namespace scc_internal
+
 /**
  * @brief 強連結成分分解を行うためのクラス
  *
@@ -23,27 +70,33 @@ public:
    *
    * @param graph 有向グラフ
    */
-  explicit SCC(const std::vector<std::vector<int>> &graph)
-    : _n(graph.size()), _comp(graph.size(), -1), _g(graph)
-  {
-    _rev_g.resize(graph.size());
-    for (int from = 0; from < _n; ++from) {
-      for (int to : graph[from]) {
-        _rev_g[to].push_back(from);
-      }
-    }
-    _solve();
-  };
+  explicit SCC(const std::vector<std::vector<int>> &graph) : SCC(CSRGraph<>(graph)) {}
+
+  /**
+   * @brief SCCクラスのコンストラクタ．O(N + M)
+   *
+   * @param graph CSR形式の有向グラフ
+   */
+  explicit SCC(const CSRGraph<> &graph) : _n(graph.size()), _comp(graph.size(), -1) {
+    _solve(graph);
+  }
 
   /**
    * @brief 各頂点の強連結成分番号をvectorで返す
    *
    * @return 各頂点の強連結成分番号を保持
    */
-  std::vector<int> comp() const {
+  const std::vector<int> &comp() const {
     return _comp;
   }
 
+  /**
+   * @brief 強連結成分の個数を返す
+   */
+  int comp_count() const {
+    return _n_comp;
+  }
+
   /**
    * @brief 2頂点が同じ強連結成分に属するかどうかを返す
    *
@@ -57,12 +110,12 @@ public:
 
   /**
    * @brief 頂点が属する強連結成分のサイズを返す
-   * 
+   *
    * @param u 頂点
    * @return uが属する強連結成分のサイズ
    */
   int comp_size(const int u) const {
-    return _siz.at(_comp[u]);
+    return _siz[_comp[u]];
   }
 
   /**
@@ -73,7 +126,7 @@ public:
   std::vector<std::vector<int>> scc() const {
     std::vector<std::vector<int>> ret(_n_comp);
     for (int i = 0; i < _n_comp; ++i) {
-      ret[i].reserve(_siz.at(i));
+      ret[i].reserve(_siz[i]);
     }
     for (int i = 0; i < _n; ++i) {
       ret[_comp[i]].push_back(i);
@@ -82,49 +135,84 @@ public:
     return ret;
   }
 
-private:
-  int _n, _n_comp;
-  std::vector<int> _comp;
-  std::vector<std::vector<int>> _g, _rev_g;
-  std::map<int, int> _siz;
-
-  void _dfs(int u, std::vector<bool> &visited, std::vector<int> &order) {
-    visited[u] = true;
-    for (int v : _g[u]) {
-      if (!visited[v]) _dfs(v, visited, order);
-    }
-    order.push_back(u);
+  /**
+   * @brief 強連結成分を1頂点に縮約したDAGをCSR形式で返す．O(N + M)
+   * @details 頂点iは成分番号iの成分であり，辺は成分番号の小さい方から大きい方へ向かう．多重辺は除く．
+   *
+   * @param graph コンストラクタに渡したグラフ
+   */
+  CSRGraph<> condensation(const CSRGraph<> &graph) const {
+    return scc_internal::condensation(graph, _comp, _n_comp);
   }
 
-  void _rdfs(int u, int comp_idx, std::vector<int> &comp, std::map<int, int> &siz) {
-    comp[u] = comp_idx;
-    ++siz[comp_idx];
-    for (int v : _rev_g[u]) {
-      if (comp[v] == -1) _rdfs(v, comp_idx, comp, siz);
-    }
+  CSRGraph<> condensation(const std::vector<std::vector<int>> &graph) const {
+    return condensation(CSRGraph<>(graph));
   }
 
-  void _solve() {
-    std::vector<bool> is_visited(_n, false);
-    std::vector<int> order;
-
-    for (int i = 0; i < _n; ++i) {
-      if (!is_visited[i]) _dfs(i, is_visited, order);
-    }
+private:
+  int _n, _n_comp = 0;
+  std::vector<int> _comp;
+  std::vector<int> _siz;
 
-    std::reverse(std::begin(order), std::end(order));
+  // DFSの経路上の頂点uと，uから到達できるスタック上の頂点のordの最小値low，uで次に調べる辺
+  struct Frame {
+    int u, low;
+    const int *it, *end;
+  };
 
-    int comp_idx = 0;
-    for (int i : order) {
-      if (_comp[i] == -1) {
-        _rdfs(i, comp_idx, _comp, _siz);
-        ++comp_idx;
+  void _solve(const CSRGraph<> &g) {
+    // 探索中は_comp[v]を，未訪問なら-1，成分が未確定ならDFSで訪れた順番ord(< n)，
+    // 確定していればn + (見つけた順の成分番号)とする．確定した頂点のordはlowの計算に影響しない
+    std::vector<int> &ord = _comp;
+    // stackは成分が未確定の頂点，callはDFSの経路
+    std::vector<int> stack;
+    std::vector<Frame> call;
+    int k = 0;
+    auto visit = [&](int v) {
+      ord[v] = k++;
+      stack.push_back(v);
+      auto adj = g.adj(v);
+      call.push_back(Frame{v, ord[v], adj.begin(), adj.end()});
+    };
+
+    for (int r = 0; r < _n; ++r) {
+      if (ord[r] != -1) continue;
+      visit(r);
+      while (!call.empty()) {
+        Frame &f = call.back();
+        if (f.it != f.end) {
+          const int v = *f.it++;
+          if (ord[v] == -1) {
+            visit(v);
+          } else if (ord[v] < f.low) {
+            f.low = ord[v];
+          }
+          continue;
+        }
+
+        const int u = f.u, low = f.low;
+        call.pop_back();
+        if (!call.empty() && low < call.back().low) call.back().low = low;
+        if (low != ord[u]) continue;
+        // uを根とする成分が確定した
+        int siz = 0;
+        while (true) {
+          const int v = stack.back();
+          stack.pop_back();
+          ord[v] = _n + _n_comp;
+          ++siz;
+          if (v == u) break;
+        }
+        _siz.push_back(siz);
+        ++_n_comp;
       }
     }
 
-    _n_comp = comp_idx;
+    // 成分はトポロジカル順の逆に見つかるので，番号を反転する
+    for (int &c : _comp) c = _n_comp - 1 - (c - _n);
+    std::reverse(_siz.begin(), _siz.end());
   }
 
 };
 
-#endif // OKINA_SCC
\ No newline at end of file
+#endif // OKINA_SCC
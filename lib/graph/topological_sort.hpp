@@ -1,35 +1,51 @@
 /**
  * @file topological_sort.hpp
  * @brief トポロジカルソートに関するコード
+ * @details
+ * * グラフはCSR形式(CSRGraph<>)で走査する．隣接リストを渡した場合はCSR形式に変換する．グラフは保持しない．
+ * * 入次数が0になった頂点から順に取り出す(Kahn法)．取り出す順番は2通り．
+ *   * Order::FIFO: 入次数が0になった順．
+ *   * Order::LEXICOGRAPHIC: 入次数が0の頂点のうち番号が最小のもの(二分ヒープ)．辞書順最小のトポロジカル順序になる．
+ * * 頂点vの層を，入次数0の頂点を0として，vに入る辺の始点の層の最大値 + 1とする．
+ *   同じ層の頂点の間には辺がないので，層の順に，各層の頂点を並列に処理できる．
  * @example topological_sort_test.cpp
  */
 #ifndef OKINA_TOPOLOGICAL_SORT
 #define OKINA_TOPOLOGICAL_SORT
 
+#include <algorithm>
 #include <cassert>
+#include <functional>
 #include <queue>
 #include <vector>
 
+#include "csr_graph.hpp"
+
 /**
  * @brief トポロジカルソートのためのクラス
  *
  */
 class TopologicalSort {
 public:
+  enum class Order { FIFO, LEXICOGRAPHIC };
+
   /**
    * @brief Topological Sortクラスのコンストラクタ
    *
    * @param graph 有向グラフ
+   * @param order 頂点を取り出す順番
    */
-  TopologicalSort(const std::vector<std::vector<int>>& graph) :
-    _n(graph.size()), _g(graph), _in_degree(graph.size()) {
-    _sorted.reserve(_n);
-    for (auto vs: graph) {
-      for (int v: vs) {
-        ++_in_degree[v];
-      }
-    }
-    _solve();
+  TopologicalSort(const std::vector<std::vector<int>>& graph, Order order = Order::FIFO) :
+    TopologicalSort(CSRGraph<>(graph), order) {}
+
+  /**
+   * @brief Topological Sortクラスのコンストラクタ．FIFOならO(N + M)，LEXICOGRAPHICならO(N log N + M)
+   *
+   * @param graph CSR形式の有向グラフ
+   * @param order 頂点を取り出す順番
+   */
+  explicit TopologicalSort(const CSRGraph<>& graph, Order order = Order::FIFO) : _n(graph.size()) {
+    _solve(graph, order);
   }
 
   /**
@@ -38,7 +54,7 @@ public:
    * @return トポロジカルソート可能かどうか
    */
   bool is_sortable() const {
-    return _sorted.size() == _g.size();
+    return static_cast<int>(_sorted.size()) == _n;
   }
 
   /**
@@ -53,28 +69,74 @@ public:
     return _sorted;
   }
 
+  /**
+   * @brief 層の数を返す．ソート可能でなければ0
+   */
+  int layer_count() const {
+    return static_cast<int>(_layer_start.size()) - 1;
+  }
+
+  /**
+   * @brief 層iの頂点の範囲を返す．範囲内の頂点はsorted()での順番に並ぶ
+   */
+  CSRRange<int> layer(int i) const {
+    assert(0 <= i && i < layer_count());
+    return CSRRange<int>(_layered.data() + _layer_start[i], _layered.data() + _layer_start[i + 1]);
+  }
+
 private:
   int _n;
-  std::vector<std::vector<int>> _g;
-  std::vector<int> _in_degree;
   std::vector<int> _sorted;
+  // 層の順に並べた頂点列と，各層の始まりの位置
+  std::vector<int> _layered, _layer_start = std::vector<int>(1, 0);
 
-  void _solve() {
-    std::queue<int> q;
-    for (int i = 0; i < _n; ++i) {
-      if (_in_degree[i] == 0) q.push(i);
+  void _solve(const CSRGraph<>& g, Order order) {
+    std::vector<int> in_degree(_n, 0), depth(_n, 0);
+    for (int u = 0; u < _n; ++u) {
+      for (int v : g.adj(u)) ++in_degree[v];
     }
+    _sorted.reserve(_n);
 
-    while (!q.empty()) {
-      int f = q.front();
-      q.pop();
+    // uを取り出し，入次数が0になった頂点をpushで追加する
+    auto pop = [&](int u, auto push) {
+      for (int v : g.adj(u)) {
+        depth[v] = std::max(depth[v], depth[u] + 1);
+        if (--in_degree[v] == 0) push(v);
+      }
+    };
 
-      _sorted.push_back(f);
-      for (int to : _g[f]) {
-        if (--_in_degree[to] == 0) q.push(to);
+    if (order == Order::FIFO) {
+      // _sortedをキューとして使う
+      for (int i = 0; i < _n; ++i) {
+        if (in_degree[i] == 0) _sorted.push_back(i);
+      }
+      for (std::size_t head = 0; head < _sorted.size(); ++head) {
+        pop(_sorted[head], [&](int v) { _sorted.push_back(v); });
+      }
+    } else {
+      std::priority_queue<int, std::vector<int>, std::greater<int>> q;
+      for (int i = 0; i < _n; ++i) {
+        if (in_degree[i] == 0) q.push(i);
+      }
+      while (!q.empty()) {
+        int u = q.top();
+        q.pop();
+        _sorted.push_back(u);
+        pop(u, [&](int v) { q.push(v); });
       }
     }
+    if (!is_sortable()) return;
+
+    // 層毎に安定に数え上げソートする．FIFOなら_sortedは既に層の順に並んでいる
+    int n_layers = 0;
+    for (int v = 0; v < _n; ++v) n_layers = std::max(n_layers, depth[v] + 1);
+    _layer_start.assign(n_layers + 1, 0);
+    for (int v = 0; v < _n; ++v) ++_layer_start[depth[v] + 1];
+    for (int i = 0; i < n_layers; ++i) _layer_start[i + 1] += _layer_start[i];
+    _layered.resize(_n);
+    std::vector<int> pos(_layer_start.begin(), _layer_start.end() - 1);
+    for (int v : _sorted) _layered[pos[depth[v]]++] = v;
   }
 };
 
-#endif // OKINA_TOPOLOGICAL_SORT
\ No newline at end of file
+#endif // OKINA_TOPOLOGICAL_SORT
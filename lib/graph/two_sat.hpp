@@ -0,0 +1,97 @@
+#pragma once
+/**
+ * @file two_sat.hpp
+ * @brief 2-SAT
+ * @details
+ * * 変数x_iが値fを取るというリテラルを頂点2i + fとする含意グラフを作り，SCCで強連結成分分解する．
+ *   * 節(a ∨ b)は辺¬a → b, ¬b → aになる．
+ *   * 含意グラフは節の配列から次数を数えて直接CSR形式で作る．隣接リストは作らない．
+ * * x_iとその否定が同じ強連結成分に属する場合は充足不能．そうでなければ，トポロジカル順で後ろにある方のリテラルを真にする．
+ * * 変数の数をN，節の数をMとしてO(N + M)．
+ * @example two_sat_test.cpp
+ */
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "csr_graph.hpp"
+#include "scc.hpp"
+
+class TwoSat {
+public:
+  /**
+   * @brief TwoSatクラスのコンストラクタ
+   *
+   * @param n 変数の数
+   */
+  explicit TwoSat(int n) : n_(n), answer_(n) {}
+
+  /**
+   * @brief 変数x_iが値fを取るというリテラルを返す．否定はliteral(i, f) ^ 1
+   */
+  static int literal(int i, bool f) { return 2 * i + (f ? 1 : 0); }
+
+  /**
+   * @brief 節の数の上限を予約する．
+   */
+  void reserve(int m) { clauses_.reserve(m); }
+
+  /**
+   * @brief 節(リテラルa ∨ リテラルb)を追加する．
+   */
+  void add_clause(int a, int b) {
+    assert(0 <= a && a < 2 * n_ && 0 <= b && b < 2 * n_);
+    clauses_.emplace_back(a, b);
+  }
+
+  /**
+   * @brief 節(x_i = f ∨ x_j = g)を追加する．
+   */
+  void add_clause(int i, bool f, int j, bool g) { add_clause(literal(i, f), literal(j, g)); }
+
+  /**
+   * @brief (リテラル，リテラル)の配列で与えられた節をまとめて追加する．
+   */
+  void add_clauses(const std::vector<std::pair<int, int>> &clauses) {
+    clauses_.reserve(clauses_.size() + clauses.size());
+    for (const auto &[a, b] : clauses) add_clause(a, b);
+  }
+
+  /**
+   * @brief 追加された全ての節を同時に満たす割り当てが存在するかを返す．O(N + M)
+   */
+  bool satisfiable() {
+    const int n_lit = 2 * n_;
+    std::vector<int> start(n_lit + 1, 0);
+    for (const auto &[a, b] : clauses_) {
+      ++start[(a ^ 1) + 1];
+      ++start[(b ^ 1) + 1];
+    }
+    for (int v = 0; v < n_lit; ++v) start[v + 1] += start[v];
+    std::vector<int> to(start[n_lit]), pos(start.begin(), start.end() - 1);
+    for (const auto &[a, b] : clauses_) {
+      to[pos[a ^ 1]++] = b;
+      to[pos[b ^ 1]++] = a;
+    }
+    std::vector<int>().swap(pos);
+
+    const SCC scc(CSRGraph<>(std::move(start), std::move(to)));
+    const std::vector<int> &comp = scc.comp();
+    for (int i = 0; i < n_; ++i) {
+      if (comp[2 * i] == comp[2 * i + 1]) return false;
+      answer_[i] = comp[2 * i] < comp[2 * i + 1];
+    }
+    return true;
+  }
+
+  /**
+   * @brief satisfiable()がtrueを返した後に呼ぶ．各変数の値を返す．
+   */
+  const std::vector<bool> &answer() const { return answer_; }
+
+private:
+  int n_;
+  std::vector<std::pair<int, int>> clauses_;
+  std::vector<bool> answer_;
+};
@@ -3,9 +3,20 @@
  * @file modint.hpp
  * @brief 素数を法とするmodに関するコード。
  * @details mod Pでの演算をサポート。
+ * * ModInt
+ *   * コンパイル時に法を与える。
+ * * DynamicModInt
+ *   * 実行時にスレッド毎の法を与える。乗算はBarrett reductionで行う。法は2^31未満。
+ * * choose, calc_fact, calc_inv_fact
+ *   * ModInt<mod>に対してはテンプレート引数にmodを、それ以外の型には型そのものを与える。
+ * * Combinatorics
+ *   * 階乗、階乗の逆数、逆数の表をO(n)で構築し、二項係数などをO(1)で返す。表は必要に応じて伸ばす。
  */
 
+#include <algorithm>
+#include <cassert>
 #include <ostream>
+#include <utility>
 #include <vector>
 
 template <long long mod>
@@ -42,9 +53,9 @@ public:
     while (b) {
       long long t = a / b;
       a -= t * b;
-      swap(a, b);
+      std::swap(a, b);
       u -= t * v;
-      swap(u, v);
+      std::swap(u, v);
     }
 
     x = x * u % mod;
@@ -69,6 +80,10 @@ public:
     return x;
   }
 
+  static constexpr long long get_mod() {
+    return mod;
+  }
+
 private:
   long long x;
 };
@@ -108,16 +123,175 @@ ModInt<mod> operator/(ModInt<mod> left, ModInt<mod> right) {
 }
 
 
-template <long long mod>
-ModInt<mod> choose(long long n, long long k) {
+/**
+ * @brief Barrett reductionによる乗算剰余。
+ * @details 2^64 / m の切り上げを前計算し、128bit積の上位64bitで商を近似する。1 <= m < 2^31。
+ */
+class Barrett {
+public:
+  explicit Barrett(unsigned int m) : m_(m), im_(static_cast<unsigned long long>(-1) / m + 1) {}
+
+  unsigned int umod() const {
+    return m_;
+  }
+
+  /**
+   * @brief a * b mod mを計算。a, b < mが必要。
+   */
+  unsigned int mul(unsigned int a, unsigned int b) const {
+    unsigned long long z = a;
+    z *= b;
+    unsigned long long q = static_cast<unsigned long long>((static_cast<unsigned __int128>(z) * im_) >> 64);
+    unsigned long long y = q * m_;
+    return static_cast<unsigned int>(z - y + (z < y ? m_ : 0));
+  }
+
+private:
+  unsigned int m_;
+  unsigned long long im_;
+};
+
+/**
+ * @brief 実行時に法を与えるModInt。
+ * @details 法はスレッド毎に保持し、set_modで変更する。既定値は998244353。
+ *   ModIntと同じ演算を持つので、calc_factやchooseなどに型として与えられる。
+ * @tparam id 異なる法を同時に使うための識別子。
+ */
+template <int id = 0>
+class DynamicModInt {
+public:
+  static void set_mod(long long m) {
+    assert(1 <= m && m < (1LL << 31));
+    barrett_() = Barrett(static_cast<unsigned int>(m));
+  }
+
+  static long long get_mod() {
+    return barrett_().umod();
+  }
+
+  DynamicModInt() {
+    this->x = 0;
+  }
+
+  DynamicModInt(long long x) {
+    long long m = get_mod();
+    long long r = x % m;
+    if (r < 0) r += m;
+    this->x = static_cast<unsigned int>(r);
+  }
+
+  DynamicModInt<id> & operator+=(const DynamicModInt<id> &right) {
+    unsigned int m = barrett_().umod();
+    if ((x += right.x) >= m) x -= m;
+    return *this;
+  }
+
+  DynamicModInt<id> & operator-=(const DynamicModInt<id> &right) {
+    unsigned int m = barrett_().umod();
+    if (x < right.x) x += m;
+    x -= right.x;
+    return *this;
+  }
+
+  DynamicModInt<id> & operator*=(const DynamicModInt<id> &right) {
+    x = barrett_().mul(x, right.x);
+    return *this;
+  }
+
+  DynamicModInt<id> & operator/=(const DynamicModInt<id> &right) {
+    return *this *= right.inv();
+  }
+
+  DynamicModInt<id> pow(long long exp) const {
+    DynamicModInt<id> ret(1), base = *this;
+    while (exp > 0) {
+      if (exp & 1) ret *= base;
+      base *= base;
+      exp >>= 1;
+    }
+    return ret;
+  }
+
+  /**
+   * @brief 拡張ユークリッドの互除法で逆元を求める。法と互いに素である必要がある。
+   */
+  DynamicModInt<id> inv() const {
+    long long a = x, b = get_mod(), u = 1, v = 0;
+    while (b) {
+      long long t = a / b;
+      a -= t * b;
+      std::swap(a, b);
+      u -= t * v;
+      std::swap(u, v);
+    }
+    assert(a == 1);
+    return DynamicModInt<id>(u);
+  }
+
+  long long get_x() const {
+    return x;
+  }
+
+private:
+  unsigned int x;
+
+  static Barrett &barrett_() {
+    static thread_local Barrett barrett(998244353);
+    return barrett;
+  }
+};
+
+template<int id>
+bool operator==(DynamicModInt<id> left, DynamicModInt<id> right) {
+  return left.get_x() == right.get_x();
+}
+
+template<int id>
+bool operator!=(DynamicModInt<id> left, DynamicModInt<id> right) {
+  return !(left == right);
+}
+
+template<int id>
+DynamicModInt<id> operator+(DynamicModInt<id> left, DynamicModInt<id> right) {
+  return left += right;
+}
+
+template<int id>
+DynamicModInt<id> operator-(DynamicModInt<id> left, DynamicModInt<id> right) {
+  return left -= right;
+}
+
+template<int id>
+DynamicModInt<id> operator*(DynamicModInt<id> left, DynamicModInt<id> right) {
+  return left *= right;
+}
+
+template<int id>
+DynamicModInt<id> operator/(DynamicModInt<id> left, DynamicModInt<id> right) {
+  return left /= right;
+}
+
+template <int id>
+std::ostream &operator<<(std::ostream &ost, const DynamicModInt<id> &m) {
+  ost << m.get_x();
+  return ost;
+}
+
+template <class Mint>
+Mint choose(long long n, long long k) {
   if (n < k || k < 0) return 0;
-  ModInt<mod> ret(1);
+  Mint num(1), den(1);
   for (long long i = 0; i < k; ++i) {
-    ret *= ModInt<mod>(n - i);
-    ret *= ModInt<mod>(k - i).inv();
+    num *= Mint(n - i);
+    den *= Mint(i + 1);
   }
 
-  return ret;
+  return num * den.inv();
+}
+
+template <long long mod>
+ModInt<mod> choose(long long n, long long k) {
+  return choose<ModInt<mod>>(n, k);
 }
 
 /**
@@ -125,24 +299,40 @@ ModInt<mod> choose(long long n, long long k) {
  * @param n 階乗を求める整数の最大値。
  * @return n以下の階乗を保持する配列。
  */
-template <long long mod>
-std::vector<ModInt<mod>> calc_fact(int n) {
-  std::vector<ModInt<mod>> fact;
+template <class Mint>
+std::vector<Mint> calc_fact(int n) {
+  std::vector<Mint> fact;
   fact.push_back(1);
   fact.push_back(1);
-  for (int i = 2; i <= n; ++i) fact.push_back(fact[i - 1] * ModInt<mod>(i));
+  for (int i = 2; i <= n; ++i) fact.push_back(fact[i - 1] * Mint(i));
   return fact;
 }
 
+template <long long mod>
+std::vector<ModInt<mod>> calc_fact(int n) {
+  return calc_fact<ModInt<mod>>(n);
+}
+
 /**
  * @brief 閾値以下の自然数に対し、階乗の逆数を計算。
  * @param n 階乗を求める整数の最大値。
  * @return n以下の階乗の逆数を保持する配列。
  */
+template <class Mint>
+void calc_inv_fact(const std::vector<Mint> &fact, std::vector<Mint> &inv_fact) {
+  // 最大の階乗の逆数だけを求め、(i - 1)!^{-1} = i!^{-1} * i で降順に埋める。O(n + log mod)
+  int n = fact.size();
+  if (n == 0) return;
+  std::size_t offset = inv_fact.size();
+  inv_fact.resize(offset + n);
+  inv_fact[offset + n - 1] = fact[n - 1].inv();
+  for (int i = n - 1; i > 0; --i) inv_fact[offset + i - 1] = inv_fact[offset + i] * Mint(i);
+  return;
+}
+
 template <long long mod>
 void calc_inv_fact(const std::vector<ModInt<mod>> &fact, std::vector<ModInt<mod>> &inv_fact) {
-  for (int i = 0; i < (int)fact.size(); ++i) inv_fact.push_back(ModInt<mod>(1) / fact[i]);
-  return;
+  calc_inv_fact<ModInt<mod>>(fact, inv_fact);
 }
 
 /**
@@ -154,13 +344,125 @@ void calc_inv_fact(const std::vector<ModInt<mod>> &fact, std::vector<ModInt<mod>
  * @param inv_fact_n_minus_k (n - k)の階乗の逆数。
  * @return n choose k。
  */
-template <long long mod>
-ModInt<mod> choose(long long n, long long k, ModInt<mod> fact_n, ModInt<mod> inv_fact_k, ModInt<mod> inv_fact_n_minus_k) {
+template <class Mint>
+Mint choose(long long n, long long k, Mint fact_n, Mint inv_fact_k, Mint inv_fact_n_minus_k) {
   if (n < k || k < 0) return 0;
 
   return fact_n * inv_fact_k * inv_fact_n_minus_k;
 }
 
+template <long long mod>
+ModInt<mod> choose(long long n, long long k, ModInt<mod> fact_n, ModInt<mod> inv_fact_k, ModInt<mod> inv_fact_n_minus_k) {
+  return choose<ModInt<mod>>(n, k, fact_n, inv_fact_k, inv_fact_n_minus_k);
+}
+
+/**
+ * @brief 階乗の表を用いて組合せの数をO(1)で求めるクラス。
+ * @details 表はO(n)で構築する。逆元は最大の階乗に対して1回だけ求める。
+ *   表より大きい引数が与えられた場合は、表のサイズを2倍以上（ただし法以下）に伸ばす。
+ * @tparam Mint ModIntまたはDynamicModInt。法は素数であり、階乗を求める値は法より小さい必要がある。
+ */
+template <class Mint>
+class Combinatorics {
+public:
+  /**
+   * @brief Combinatoricsクラスのコンストラクタ。
+   * @param n 前計算する階乗の最大値。
+   */
+  explicit Combinatorics(int n = 1) {
+    fact_.push_back(1);
+    inv_fact_.push_back(1);
+    inv_.push_back(0);
+    extend_(n);
+  }
+
+  Mint fact(int n) {
+    extend_(n);
+    return fact_[n];
+  }
+
+  Mint inv_fact(int n) {
+    extend_(n);
+    return inv_fact_[n];
+  }
+
+  /**
+   * @brief nの逆数を返す。n >= 1。
+   */
+  Mint inv(int n) {
+    extend_(n);
+    return inv_[n];
+  }
+
+  /**
+   * @brief n個からk個を選ぶ組合せの数。
+   */
+  Mint C(long long n, long long k) {
+    if (n < 0 || k < 0 || n < k) return 0;
+    extend_(n);
+    return fact_[n] * inv_fact_[k] * inv_fact_[n - k];
+  }
+
+  /**
+   * @brief n個からk個を選んで並べる順列の数。
+   */
+  Mint P(long long n, long long k) {
+    if (n < 0 || k < 0 || n < k) return 0;
+    extend_(n);
+    return fact_[n] * inv_fact_[n - k];
+  }
+
+  /**
+   * @brief n種類から重複を許してk個を選ぶ組合せの数。
+   */
+  Mint H(long long n, long long k) {
+    if (n == 0 && k == 0) return 1;
+    return C(n + k - 1, k);
+  }
+
+  /**
+   * @brief n番目のカタラン数。
+   */
+  Mint catalan(long long n) {
+    if (n < 0) return 0;
+    extend_(std::max(2 * n, n + 1));
+    return fact_[2 * n] * inv_fact_[n] * inv_fact_[n + 1];
+  }
+
+  /**
+   * @brief 多項係数 (k_1 + ... + k_m)! / (k_1! ... k_m!)。
+   */
+  Mint multinomial(const std::vector<int> &ks) {
+    long long sum = 0;
+    for (int k : ks) {
+      if (k < 0) return 0;
+      sum += k;
+    }
+    extend_(sum);
+    Mint ret = fact_[sum];
+    for (int k : ks) ret *= inv_fact_[k];
+    return ret;
+  }
+
+private:
+  std::vector<Mint> fact_, inv_fact_, inv_;
+
+  void extend_(long long n) {
+    int old_size = fact_.size();
+    if (n < old_size) return;
+    // 法以上のiではMint(i)が0の倍数になり逆元が壊れるので，表は法を超えて伸ばさない。
+    assert(n < Mint::get_mod());
+    int new_size = std::min<long long>(std::max<long long>(n + 1, 2LL * old_size), Mint::get_mod());
+    fact_.resize(new_size);
+    inv_fact_.resize(new_size);
+    inv_.resize(new_size);
+    for (int i = old_size; i < new_size; ++i) fact_[i] = fact_[i - 1] * Mint(i);
+    inv_fact_[new_size - 1] = fact_[new_size - 1].inv();
+    for (int i = new_size - 1; i > old_size; --i) inv_fact_[i - 1] = inv_fact_[i] * Mint(i);
+    for (int i = std::max(old_size, 1); i < new_size; ++i) inv_[i] = inv_fact_[i] * fact_[i - 1];
+  }
+};
+
 template <long long mod>
 std::ostream &operator<<(std::ostream &ost, const ModInt<mod> &m) {
   ost << m.get_x();
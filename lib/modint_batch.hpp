@@ -0,0 +1,240 @@
+#pragma once
+/**
+ * @file modint_batch.hpp
+ * @brief ModIntの連続した配列に対する一括演算。
+ * @details
+ * * batch_add, batch_sub, batch_mul
+ *   * 要素毎の加算、減算、乗算。
+ * * batch_axpy
+ *   * y += alpha * x。
+ * * batch_dot
+ *   * 内積。
+ * * batch_prefix_product
+ *   * 累積積。
+ * * batch_inv
+ *   * 全要素の逆元。Montgomeryの一括逆元により、逆元の計算は全体で1回のみ。
+ *
+ * AVX2が有効で、法が2^31未満の奇数であれば4要素ずつ計算する。
+ * 乗算はR = 2^32としたMontgomery乗算をレーン毎に行う。
+ * それ以外の場合はModIntの演算子による逐次計算となる。
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "modint.hpp"
+
+namespace modint_batch_internal {
+
+template <long long mod>
+constexpr bool use_simd() {
+#ifdef __AVX2__
+  return mod % 2 == 1 && mod < (1LL << 31) && sizeof(ModInt<mod>) == sizeof(long long);
+#else
+  return false;
+#endif
+}
+
+#ifdef __AVX2__
+/**
+ * @brief R = 2^32としたMontgomery乗算の定数。
+ */
+template <long long mod>
+struct MontgomeryConst {
+  // -mod^{-1} mod 2^32
+  static constexpr std::uint32_t neg_inv() {
+    std::uint32_t inv = static_cast<std::uint32_t>(mod);
+    for (int i = 0; i < 5; ++i) inv *= 2 - static_cast<std::uint32_t>(mod) * inv;
+    return -inv;
+  }
+
+  // R^2 mod mod
+  static constexpr std::uint64_t r2() {
+    std::uint64_t r = (1ULL << 32) % mod;
+    return r * r % mod;
+  }
+};
+
+inline const long long *raw(const void *p) {
+  return static_cast<const long long *>(p);
+}
+
+inline long long *raw(void *p) {
+  return static_cast<long long *>(p);
+}
+
+inline __m256i load(const long long *p) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+inline void store(long long *p, __m256i v) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+}
+
+template <long long mod>
+inline __m256i add(__m256i a, __m256i b) {
+  const __m256i m = _mm256_set1_epi64x(mod);
+  const __m256i m_minus_one = _mm256_set1_epi64x(mod - 1);
+  __m256i s = _mm256_add_epi64(a, b);
+  return _mm256_sub_epi64(s, _mm256_and_si256(_mm256_cmpgt_epi64(s, m_minus_one), m));
+}
+
+template <long long mod>
+inline __m256i sub(__m256i a, __m256i b) {
+  const __m256i m = _mm256_set1_epi64x(mod);
+  __m256i d = _mm256_sub_epi64(a, b);
+  return _mm256_add_epi64(d, _mm256_and_si256(_mm256_cmpgt_epi64(_mm256_setzero_si256(), d), m));
+}
+
+/**
+ * @brief a * b * R^{-1} mod modを求める。a, b < mod。
+ */
+template <long long mod>
+inline __m256i mont_mul(__m256i a, __m256i b) {
+  const __m256i m = _mm256_set1_epi64x(mod);
+  const __m256i m_minus_one = _mm256_set1_epi64x(mod - 1);
+  const __m256i neg_inv = _mm256_set1_epi64x(MontgomeryConst<mod>::neg_inv());
+  __m256i t = _mm256_mul_epu32(a, b);
+  __m256i q = _mm256_mul_epu32(t, neg_inv);
+  __m256i u = _mm256_srli_epi64(_mm256_add_epi64(t, _mm256_mul_epu32(q, m)), 32);
+  return _mm256_sub_epi64(u, _mm256_and_si256(_mm256_cmpgt_epi64(u, m_minus_one), m));
+}
+
+template <long long mod>
+inline __m256i mul(__m256i a, __m256i b) {
+  const __m256i r2 = _mm256_set1_epi64x(MontgomeryConst<mod>::r2());
+  return mont_mul<mod>(mont_mul<mod>(a, b), r2);
+}
+#endif
+
+} // namespace modint_batch_internal
+
+/**
+ * @brief dst[i] = a[i] + b[i]。dstはaまたはbと同じでもよい。
+ */
+template <long long mod>
+void batch_add(ModInt<mod> *dst, const ModInt<mod> *a, const ModInt<mod> *b, std::size_t n) {
+  std::size_t i = 0;
+#ifdef __AVX2__
+  if constexpr (modint_batch_internal::use_simd<mod>()) {
+    namespace in = modint_batch_internal;
+    for (; i + 4 <= n; i += 4) {
+      in::store(in::raw(dst + i), in::add<mod>(in::load(in::raw(a + i)), in::load(in::raw(b + i))));
+    }
+  }
+#endif
+  for (; i < n; ++i) dst[i] = a[i] + b[i];
+}
+
+/**
+ * @brief dst[i] = a[i] - b[i]。dstはaまたはbと同じでもよい。
+ */
+template <long long mod>
+void batch_sub(ModInt<mod> *dst, const ModInt<mod> *a, const ModInt<mod> *b, std::size_t n) {
+  std::size_t i = 0;
+#ifdef __AVX2__
+  if constexpr (modint_batch_internal::use_simd<mod>()) {
+    namespace in = modint_batch_internal;
+    for (; i + 4 <= n; i += 4) {
+      in::store(in::raw(dst + i), in::sub<mod>(in::load(in::raw(a + i)), in::load(in::raw(b + i))));
+    }
+  }
+#endif
+  for (; i < n; ++i) dst[i] = a[i] - b[i];
+}
+
+/**
+ * @brief dst[i] = a[i] * b[i]。dstはaまたはbと同じでもよい。
+ */
+template <long long mod>
+void batch_mul(ModInt<mod> *dst, const ModInt<mod> *a, const ModInt<mod> *b, std::size_t n) {
+  std::size_t i = 0;
+#ifdef __AVX2__
+  if constexpr (modint_batch_internal::use_simd<mod>()) {
+    namespace in = modint_batch_internal;
+    for (; i + 4 <= n; i += 4) {
+      in::store(in::raw(dst + i), in::mul<mod>(in::load(in::raw(a + i)), in::load(in::raw(b + i))));
+    }
+  }
+#endif
+  for (; i < n; ++i) dst[i] = a[i] * b[i];
+}
+
+/**
+ * @brief y[i] += alpha * x[i]。
+ */
+template <long long mod>
+void batch_axpy(ModInt<mod> *y, ModInt<mod> alpha, const ModInt<mod> *x, std::size_t n) {
+  std::size_t i = 0;
+#ifdef __AVX2__
+  if constexpr (modint_batch_internal::use_simd<mod>()) {
+    namespace in = modint_batch_internal;
+    // alpha * R をかけてからMontgomery還元すれば、1回の還元でalpha * xが得られる
+    const long long alpha_r = static_cast<long long>((static_cast<unsigned long long>(alpha.get_x()) << 32) % mod);
+    const __m256i va = _mm256_set1_epi64x(alpha_r);
+    for (; i + 4 <= n; i += 4) {
+      __m256i ax = in::mont_mul<mod>(in::load(in::raw(x + i)), va);
+      in::store(in::raw(y + i), in::add<mod>(in::load(in::raw(y + i)), ax));
+    }
+  }
+#endif
+  for (; i < n; ++i) y[i] += alpha * x[i];
+}
+
+/**
+ * @brief Σ a[i] * b[i]を返す。
+ */
+template <long long mod>
+ModInt<mod> batch_dot(const ModInt<mod> *a, const ModInt<mod> *b, std::size_t n) {
+  ModInt<mod> ret;
+  std::size_t i = 0;
+#ifdef __AVX2__
+  if constexpr (modint_batch_internal::use_simd<mod>()) {
+    namespace in = modint_batch_internal;
+    __m256i acc = _mm256_setzero_si256();
+    for (; i + 4 <= n; i += 4) {
+      acc = in::add<mod>(acc, in::mul<mod>(in::load(in::raw(a + i)), in::load(in::raw(b + i))));
+    }
+    alignas(32) long long lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+    for (long long lane : lanes) ret += ModInt<mod>(lane);
+  }
+#endif
+  for (; i < n; ++i) ret += a[i] * b[i];
+  return ret;
+}
+
+/**
+ * @brief dst[i] = a[0] * a[1] * ... * a[i]。dstはaと同じでもよい。
+ */
+template <long long mod>
+void batch_prefix_product(ModInt<mod> *dst, const ModInt<mod> *a, std::size_t n) {
+  ModInt<mod> acc(1);
+  for (std::size_t i = 0; i < n; ++i) {
+    acc *= a[i];
+    dst[i] = acc;
+  }
+}
+
+/**
+ * @brief dst[i] = a[i]^{-1}。全要素が0でない必要がある。dstはaと同じでもよい。
+ * @details 累積積の逆元を1回だけ求め、後ろから各要素の逆元を取り出す。O(n + log mod)
+ */
+template <long long mod>
+void batch_inv(ModInt<mod> *dst, const ModInt<mod> *a, std::size_t n) {
+  if (n == 0) return;
+  std::vector<ModInt<mod>> prefix(n);
+  batch_prefix_product(prefix.data(), a, n);
+  ModInt<mod> inv_acc = prefix[n - 1].inv();
+  for (std::size_t i = n - 1; i > 0; --i) {
+    ModInt<mod> ai = a[i];
+    dst[i] = inv_acc * prefix[i - 1];
+    inv_acc *= ai;
+  }
+  dst[0] = inv_acc;
+}
@@ -1,11 +1,29 @@
 /**
  * @file prime_number.hpp
  * @brief 素数に関するコード
+ * @details
+ * * make_is_prime, enum_prime_nums
+ *   * エラトステネスの篩．O(n log log n)時間，O(n)空間．
+ * * SegmentedSieve
+ *   * 区間篩．奇数のみを1ビットで表し，L1キャッシュに収まる区間ごとに篩う．
+ *   * O(n log log n)時間，O(sqrt(n) + スレッド数 * チャンクサイズ)空間で10^11程度まで列挙できる．
+ *   * チャンク単位で複数スレッドに分配し，素数は昇順にコールバックへ渡す．
+ *   * 下限loを与えると[lo, n]の部分だけを篩う．
+ * * LinearSieve
+ *   * 線形篩．O(n)で最小素因数表を構築し，O(log x)で素因数分解する．
+ *   * オイラーのφ関数，メビウス関数，約数の個数の表をO(n)で求める．
+ * * miller_rabin, pollard_rho_factorize
+ *   * 64bit整数の決定的素数判定と，Pollard-Brentのρ法による素因数分解．
+ *   * 乗算剰余はMontgomery乗算で行う．
  * @example prime_number_test.cpp
  */
 #ifndef OKINA_PRIME_NUMBER
 #define OKINA_PRIME_NUMBER
 
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <utility>
 #include <vector>
 
 /**
@@ -15,13 +33,14 @@
  * @return 0以上n以下の整数の素数判定表
  */
 std::vector<bool> make_is_prime(int n) {
+  if (n < 1) return std::vector<bool>(std::max(n + 1, 0), false);
   std::vector<bool> is_prime(n + 1, true);
   is_prime[0] = false;
   is_prime[1] = false;
-  for (int i = 2; i < n; ++i) {
+  for (long long i = 2; i * i <= n; ++i) {
     if (!is_prime[i]) continue;
 
-    for (int j = 2 * i; j <= n; j += i) {
+    for (long long j = i * i; j <= n; j += i) {
       is_prime[j] = false;
     }
   }
@@ -36,22 +55,496 @@ std::vector<bool> make_is_prime(int n) {
  * @return 0以上n以下の素数で構築された配列
  */
 std::vector<int> enum_prime_nums(int n) {
-  std::vector<bool> is_prime(n + 1, true);
-  is_prime[0] = false;
-  is_prime[1] = false;
-
   std::vector<int> prime_nums;
-  for (int i = 2; i < n; ++i) {
-    if (!is_prime[i]) continue;
+  if (n < 2) return prime_nums;
 
-    prime_nums.push_back(i);
+  std::vector<bool> is_prime = make_is_prime(n);
+  for (int i = 2; i <= n; ++i) {
+    if (is_prime[i]) prime_nums.push_back(i);
+  }
 
-    for (int j = 2 * i; j <= n; j += i) {
-      is_prime[j] = false;
+  return prime_nums;
+}
+
+/**
+ * @brief 区間篩で素数を列挙するためのクラス
+ * @details 奇数2k+1をビットkで表し，segment_bytesバイトの区間ごとに篩う．
+ *   連続するsegments_per_chunk個の区間をチャンクとしてスレッドに割り当てる．
+ */
+class SegmentedSieve {
+public:
+  /**
+   * @brief SegmentedSieveクラスのコンストラクタ．sqrt(n)以下の素数を前計算する．
+   *
+   * @param n この値以下の素数を扱う
+   * @param n_threads 篩に使うスレッド数
+   * @param segment_bytes 1区間のバイト数．L1キャッシュに収まる大きさにする
+   * @param segments_per_chunk 1スレッドが一度に処理する区間数
+   */
+  explicit SegmentedSieve(long long n, int n_threads = 1,
+                          int segment_bytes = 32 * 1024, int segments_per_chunk = 16)
+    : n_(n), n_threads_(std::max(n_threads, 1)),
+      segment_bits_(std::max(segment_bytes / 8, 1) * 64LL),
+      chunk_bits_(segment_bits_ * std::max(segments_per_chunk, 1))
+  {
+    long long r = 0;
+    while ((r + 1) * (r + 1) <= n_) ++r;
+    for (int p : enum_prime_nums(static_cast<int>(r))) {
+      if (p != 2) base_primes_.push_back(p);
     }
   }
 
-  return prime_nums;
+  /**
+   * @brief lo以上n以下の素数を昇順にコールバックへ渡す
+   *
+   * @param lo 下限
+   * @param callback void(long long)として呼び出せる関数
+   */
+  template <class Callback>
+  void for_each(long long lo, Callback callback) const {
+    if (n_ < 2 || lo > n_) return;
+    if (lo <= 2) callback(2LL);
+    run_(lo, [&](long long k_begin, const std::vector<std::uint64_t> &bits) {
+      for (std::size_t w = 0; w < bits.size(); ++w) {
+        std::uint64_t word = bits[w];
+        while (word) {
+          long long k = k_begin + static_cast<long long>(w) * 64 + __builtin_ctzll(word);
+          callback(2 * k + 1);
+          word &= word - 1;
+        }
+      }
+    });
+  }
+
+  /**
+   * @brief n以下の素数を昇順にコールバックへ渡す
+   */
+  template <class Callback>
+  void for_each(Callback callback) const {
+    for_each(0, callback);
+  }
+
+  /**
+   * @brief lo以上n以下の素数の個数を返す
+   */
+  long long count(long long lo = 0) const {
+    if (n_ < 2 || lo > n_) return 0;
+    long long ret = lo <= 2 ? 1 : 0;
+    run_(lo, [&](long long, const std::vector<std::uint64_t> &bits) {
+      for (std::uint64_t word : bits) ret += __builtin_popcountll(word);
+    });
+    return ret;
+  }
+
+private:
+  long long n_;
+  int n_threads_;
+  long long segment_bits_, chunk_bits_;
+  std::vector<int> base_primes_;
+
+  // 奇数2k+1(k_begin <= k < k_end)を篩い，素数に対応するビットを立てる
+  void sieve_chunk_(long long k_begin, long long k_end, std::vector<std::uint64_t> &bits) const {
+    long long len = k_end - k_begin;
+    bits.assign((len + 63) / 64, ~std::uint64_t(0));
+    if (len % 64) bits.back() = (std::uint64_t(1) << (len % 64)) - 1;
+    if (k_begin == 0) bits[0] &= ~std::uint64_t(1); // 1は素数でない
+
+    long long max_num = 2 * (k_end - 1) + 1;
+    std::vector<long long> next; // 各素数の次に消すビットの，チャンク先頭からの位置
+    next.reserve(base_primes_.size());
+    for (int p : base_primes_) {
+      long long pp = static_cast<long long>(p) * p;
+      if (pp > max_num) break;
+      long long k0 = (pp - 1) / 2;
+      next.push_back(k0 >= k_begin ? k0 - k_begin : (p - (k_begin - k0) % p) % p);
+    }
+
+    for (long long seg = 0; seg < len; seg += segment_bits_) {
+      long long seg_end = std::min(seg + segment_bits_, len);
+      for (std::size_t i = 0; i < next.size(); ++i) {
+        long long j = next[i];
+        const long long p = base_primes_[i];
+        for (; j < seg_end; j += p) bits[j >> 6] &= ~(std::uint64_t(1) << (j & 63));
+        next[i] = j;
+      }
+    }
+  }
+
+  // lo以上の奇数のチャンクを昇順にhandlerへ渡す．各ラウンドでn_threads_個のチャンクを並列に篩う
+  template <class Handler>
+  void run_(long long lo, Handler handler) const {
+    const long long k_total = (n_ + 1) / 2;
+    // 2k + 1 >= loとなる最小のk
+    const long long k_first = std::max(lo, 0LL) / 2;
+    std::vector<std::vector<std::uint64_t>> buffers(n_threads_);
+    for (long long k = k_first; k < k_total; k += chunk_bits_ * n_threads_) {
+      std::vector<std::thread> workers;
+      int used = 0;
+      for (int t = 0; t < n_threads_; ++t) {
+        long long k_begin = k + chunk_bits_ * t;
+        if (k_begin >= k_total) break;
+        long long k_end = std::min(k_begin + chunk_bits_, k_total);
+        ++used;
+        if (t == n_threads_ - 1 || k_end == k_total) {
+          sieve_chunk_(k_begin, k_end, buffers[t]);
+        } else {
+          workers.emplace_back([this, k_begin, k_end, &buffers, t] {
+            sieve_chunk_(k_begin, k_end, buffers[t]);
+          });
+        }
+      }
+      for (std::thread &worker : workers) worker.join();
+      for (int t = 0; t < used; ++t) handler(k + chunk_bits_ * t, buffers[t]);
+    }
+  }
+};
+
+/**
+ * @brief 線形篩で最小素因数表を構築するクラス
+ */
+class LinearSieve {
+public:
+  // 2^31未満の整数の相異なる素因数は高々9個
+  static constexpr int MAX_DISTINCT_FACTORS = 9;
+
+  /**
+   * @brief LinearSieveクラスのコンストラクタ．O(n)
+   *
+   * @param n この値以下の整数の最小素因数を求める
+   */
+  explicit LinearSieve(int n) : n_(std::max(n, 1)), spf_(n_ + 1, 0) {
+    spf_[1] = 1;
+    for (int i = 2; i <= n_; ++i) {
+      if (spf_[i] == 0) {
+        spf_[i] = i;
+        primes_.push_back(i);
+      }
+      for (int p : primes_) {
+        if (static_cast<std::uint32_t>(p) > spf_[i] || static_cast<long long>(i) * p > n_) break;
+        spf_[i * p] = p;
+      }
+    }
+  }
+
+  bool is_prime(int x) const {
+    return x >= 2 && spf_[x] == static_cast<std::uint32_t>(x);
+  }
+
+  /**
+   * @brief xの最小素因数を返す．ただしspf(1) = 1
+   */
+  int smallest_prime_factor(int x) const {
+    return spf_[x];
+  }
+
+  /**
+   * @brief n以下の素数を昇順に返す
+   */
+  const std::vector<int> &primes() const {
+    return primes_;
+  }
+
+  /**
+   * @brief xを素因数分解する．O(log x)
+   * @details ヒープ領域を確保せず，呼び出し側が用意したバッファに書き込む．
+   *
+   * @param x 1以上n以下の整数
+   * @param out (素因数，指数)を書き込むバッファ．MAX_DISTINCT_FACTORS以上の長さが必要
+   * @return 相異なる素因数の個数
+   */
+  int factorize(int x, std::pair<int, int> *out) const {
+    int cnt = 0;
+    while (x > 1) {
+      int p = spf_[x];
+      int e = 0;
+      do {
+        x /= p;
+        ++e;
+      } while (x % p == 0);
+      out[cnt++] = std::make_pair(p, e);
+    }
+    return cnt;
+  }
+
+  /**
+   * @brief xを素因数分解する．O(log x)
+   *
+   * @return (素因数，指数)の配列
+   */
+  std::vector<std::pair<int, int>> factorize(int x) const {
+    std::pair<int, int> buf[MAX_DISTINCT_FACTORS];
+    int cnt = factorize(x, buf);
+    return std::vector<std::pair<int, int>>(buf, buf + cnt);
+  }
+
+  /**
+   * @brief n以下の整数に対するオイラーのφ関数の表を返す．O(n)
+   */
+  std::vector<int> phi_table() const {
+    std::vector<int> phi(n_ + 1, 0);
+    if (n_ >= 1) phi[1] = 1;
+    for (int i = 2; i <= n_; ++i) {
+      int p = spf_[i], j = i / p;
+      phi[i] = (j % p == 0) ? phi[j] * p : phi[j] * (p - 1);
+    }
+    return phi;
+  }
+
+  /**
+   * @brief n以下の整数に対するメビウス関数の表を返す．O(n)
+   */
+  std::vector<int> mobius_table() const {
+    std::vector<int> mu(n_ + 1, 0);
+    if (n_ >= 1) mu[1] = 1;
+    for (int i = 2; i <= n_; ++i) {
+      int p = spf_[i], j = i / p;
+      mu[i] = (j % p == 0) ? 0 : -mu[j];
+    }
+    return mu;
+  }
+
+  /**
+   * @brief n以下の整数に対する約数の個数の表を返す．O(n)
+   */
+  std::vector<int> divisor_count_table() const {
+    std::vector<int> d(n_ + 1, 0);
+    // 最小素因数の指数
+    std::vector<std::uint8_t> e(n_ + 1, 0);
+    if (n_ >= 1) d[1] = 1;
+    for (int i = 2; i <= n_; ++i) {
+      int p = spf_[i], j = i / p;
+      if (j % p == 0) {
+        e[i] = e[j] + 1;
+        d[i] = d[j] / (e[j] + 1) * (e[i] + 1);
+      } else {
+        e[i] = 1;
+        d[i] = d[j] * 2;
+      }
+    }
+    return d;
+  }
+
+private:
+  int n_;
+  std::vector<std::uint32_t> spf_;
+  std::vector<int> primes_;
+};
+
+/**
+ * @brief 実行時に与える奇数の法に対するMontgomery乗算
+ * @details 値はMontgomery表現(x * 2^64 mod n)で[0, n)に保持する．n < 2^63が必要．
+ */
+class Montgomery64 {
+public:
+  using u64 = unsigned long long;
+  using u128 = unsigned __int128;
+
+  explicit Montgomery64(u64 n) : n_(n), n_inv_(n), r2_(static_cast<u64>(-static_cast<u128>(n) % n)) {
+    // ニュートン法で n^{-1} mod 2^64 を求める
+    for (int i = 0; i < 5; ++i) n_inv_ *= 2 - n * n_inv_;
+  }
+
+  u64 mod() const { return n_; }
+
+  u64 to_mont(u64 x) const { return mul(x % n_, r2_); }
+  u64 from_mont(u64 x) const { return reduce_(x); }
+  u64 one() const { return to_mont(1); }
+
+  u64 add(u64 a, u64 b) const {
+    u64 c = a + b;
+    return c >= n_ ? c - n_ : c;
+  }
+
+  u64 sub(u64 a, u64 b) const {
+    return a >= b ? a - b : a + n_ - b;
+  }
+
+  u64 mul(u64 a, u64 b) const { return reduce_(static_cast<u128>(a) * b); }
+
+  u64 pow(u64 a, u64 exp) const {
+    u64 ret = one();
+    while (exp) {
+      if (exp & 1) ret = mul(ret, a);
+      a = mul(a, a);
+      exp >>= 1;
+    }
+    return ret;
+  }
+
+private:
+  u64 n_, n_inv_, r2_;
+
+  u64 reduce_(u128 t) const {
+    u64 m = static_cast<u64>(t) * -n_inv_;
+    u64 ret = static_cast<u64>((t + static_cast<u128>(m) * n_) >> 64);
+    return ret >= n_ ? ret - n_ : ret;
+  }
+};
+
+/**
+ * @brief 2^63以上の法に対する，Montgomery64と同じ形の乗算剰余
+ */
+class NaiveMod64 {
+public:
+  using u64 = unsigned long long;
+  using u128 = unsigned __int128;
+
+  explicit NaiveMod64(u64 n) : n_(n) {}
+
+  u64 mod() const { return n_; }
+  u64 to_mont(u64 x) const { return x % n_; }
+  u64 from_mont(u64 x) const { return x; }
+  u64 one() const { return 1 % n_; }
+  u64 add(u64 a, u64 b) const { return a >= n_ - b ? a - (n_ - b) : a + b; }
+  u64 sub(u64 a, u64 b) const { return a >= b ? a - b : a + (n_ - b); }
+  u64 mul(u64 a, u64 b) const { return static_cast<u64>(static_cast<u128>(a) * b % n_); }
+
+  u64 pow(u64 a, u64 exp) const {
+    u64 ret = one();
+    while (exp) {
+      if (exp & 1) ret = mul(ret, a);
+      a = mul(a, a);
+      exp >>= 1;
+    }
+    return ret;
+  }
+
+private:
+  u64 n_;
+};
+
+namespace prime_number_internal {
+
+using u64 = unsigned long long;
+
+inline u64 gcd(u64 a, u64 b) {
+  while (b) {
+    u64 t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+template <class Mod>
+bool miller_rabin(u64 n, const Mod &md, const u64 *bases, int n_bases) {
+  u64 d = n - 1;
+  int s = __builtin_ctzll(d);
+  d >>= s;
+  const u64 one = md.one(), minus_one = md.sub(0, one);
+  for (int i = 0; i < n_bases; ++i) {
+    u64 a = bases[i] % n;
+    if (a == 0) continue;
+    u64 x = md.pow(md.to_mont(a), d);
+    if (x == one || x == minus_one) continue;
+    bool composite = true;
+    for (int r = 1; r < s; ++r) {
+      x = md.mul(x, x);
+      if (x == minus_one) {
+        composite = false;
+        break;
+      }
+    }
+    if (composite) return false;
+  }
+  return true;
+}
+
+// Pollard-Brentのρ法で非自明な約数を1つ求める．nは奇数の合成数
+template <class Mod>
+u64 pollard_brent(u64 n, const Mod &md, u64 &seed) {
+  // 差の積をBATCH回分まとめてからgcdを取る
+  constexpr int BATCH = 128;
+  while (true) {
+    seed ^= seed << 7;
+    seed ^= seed >> 9;
+    const u64 c = md.to_mont(seed % (n - 1) + 1);
+    auto f = [&](u64 x) { return md.add(md.mul(x, x), c); };
+
+    u64 x = 0, y = md.to_mont(seed % n), ys = 0, q = md.one(), g = 1;
+    for (u64 r = 1; g == 1; r <<= 1) {
+      x = y;
+      for (u64 i = 0; i < r; ++i) y = f(y);
+      for (u64 k = 0; k < r && g == 1; k += BATCH) {
+        ys = y;
+        for (u64 i = 0; i < BATCH && i < r - k; ++i) {
+          y = f(y);
+          q = md.mul(q, md.sub(x, y));
+        }
+        g = gcd(md.from_mont(q), n);
+      }
+    }
+    if (g == n) {
+      // まとめすぎた場合は1歩ずつ戻って約数を探す
+      do {
+        ys = f(ys);
+        g = gcd(md.from_mont(md.sub(x, ys)), n);
+      } while (g == 1);
+    }
+    if (g != n) return g;
+  }
+}
+
+inline bool is_prime_odd(u64 n) {
+  static const u64 small_bases[] = {2, 7, 61};
+  static const u64 large_bases[] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+  if (n < (u64(1) << 63)) {
+    Montgomery64 md(n);
+    if (n < (u64(1) << 32)) return miller_rabin(n, md, small_bases, 3);
+    return miller_rabin(n, md, large_bases, 7);
+  }
+  return miller_rabin(n, NaiveMod64(n), large_bases, 7);
+}
+
+inline void factorize_odd(u64 n, std::vector<u64> &factors, u64 &seed) {
+  if (n == 1) return;
+  if (is_prime_odd(n)) {
+    factors.push_back(n);
+    return;
+  }
+  u64 d = n < (u64(1) << 63) ? pollard_brent(n, Montgomery64(n), seed)
+                             : pollard_brent(n, NaiveMod64(n), seed);
+  factorize_odd(d, factors, seed);
+  factorize_odd(n / d, factors, seed);
+}
+
+} // namespace prime_number_internal
+
+/**
+ * @brief 64bit整数の決定的素数判定(Miller-Rabin)．O(log n)
+ */
+inline bool miller_rabin(unsigned long long n) {
+  if (n < 2) return false;
+  for (unsigned long long p : {2ULL, 3ULL, 5ULL, 7ULL, 11ULL, 13ULL, 17ULL, 19ULL, 23ULL, 29ULL, 31ULL, 37ULL}) {
+    if (n % p == 0) return n == p;
+  }
+  if (n < 41 * 41) return true;
+  return prime_number_internal::is_prime_odd(n);
+}
+
+/**
+ * @brief 64bit整数をPollard-Brentのρ法で素因数分解する．期待O(n^{1/4})
+ *
+ * @return (素因数，指数)を素因数の昇順に並べた配列
+ */
+inline std::vector<std::pair<unsigned long long, int>> pollard_rho_factorize(unsigned long long n) {
+  std::vector<std::pair<unsigned long long, int>> ret;
+  if (n <= 1) return ret;
+  std::vector<unsigned long long> factors;
+  for (unsigned long long p : {2ULL, 3ULL, 5ULL, 7ULL, 11ULL, 13ULL, 17ULL, 19ULL, 23ULL, 29ULL, 31ULL, 37ULL}) {
+    while (n % p == 0) {
+      n /= p;
+      factors.push_back(p);
+    }
+  }
+  unsigned long long seed = 0x9e3779b97f4a7c15ULL ^ n;
+  prime_number_internal::factorize_odd(n, factors, seed);
+  std::sort(factors.begin(), factors.end());
+  for (unsigned long long p : factors) {
+    if (!ret.empty() && ret.back().first == p) ++ret.back().second;
+    else ret.emplace_back(p, 1);
+  }
+  return ret;
 }
 
 #endif // OKINA_PRIME_NUMBER
\ No newline at end of file
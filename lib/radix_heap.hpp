@@ -0,0 +1,91 @@
+#pragma once
+/**
+ * @file radix_heap.hpp
+ * @brief Radix Heapに関するコード。
+ * @details
+ * * 非負整数キーの単調ヒープ。取り出したキーの最小値未満のキーは挿入できない(Dijkstra法の条件を満たす)。
+ * * キーをビット幅+1個のバケットに分け，最後に取り出したキーとの最上位の異なるビットでバケットを決める。
+ * * push: O(1)，pop: ならしO(log C)。Cはキーの最大値。
+ * * decrease-keyは持たないので，同じ要素が複数回入りうる。取り出した側で古い値を読み飛ばす。
+ */
+
+#include <cassert>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Radix Heap(最小ヒープ)。
+ * @tparam Key 非負整数のキーの型。
+ * @tparam Value キーに付随する値の型。
+ */
+template <typename Key, typename Value = int>
+class RadixHeap {
+  static_assert(std::is_integral<Key>::value, "RadixHeap requires an integral key");
+  using UKey = typename std::make_unsigned<Key>::type;
+  static constexpr int N_BUCKETS = std::numeric_limits<UKey>::digits + 1;
+
+public:
+  /**
+   * @brief DaryHeapと同じ形で構築できるようにするための引数。使用しない。
+   */
+  explicit RadixHeap(int = 0) : size_(0), last_(0) {}
+
+  void resize(int) { clear(); }
+
+  bool empty() const { return size_ == 0; }
+  int size() const { return size_; }
+
+  /**
+   * @brief (key, v)を挿入する。keyは最後に取り出したキー以上である必要がある。
+   */
+  void push(Key key, Value v) {
+    UKey k = static_cast<UKey>(key);
+    assert(k >= last_);
+    buckets_[bucket_(k)].emplace_back(k, v);
+    ++size_;
+  }
+
+  /**
+   * @brief キーが最小の(キー，値)を取り除いて返す。
+   */
+  std::pair<Key, Value> pop() {
+    assert(size_ > 0);
+    if (buckets_[0].empty()) {
+      int i = 1;
+      while (buckets_[i].empty()) ++i;
+      UKey new_last = buckets_[i][0].first;
+      for (const auto &kv : buckets_[i]) {
+        if (kv.first < new_last) new_last = kv.first;
+      }
+      last_ = new_last;
+      for (const auto &kv : buckets_[i]) buckets_[bucket_(kv.first)].push_back(kv);
+      buckets_[i].clear();
+    }
+    auto [k, v] = buckets_[0].back();
+    buckets_[0].pop_back();
+    --size_;
+    return std::make_pair(static_cast<Key>(k), v);
+  }
+
+  /**
+   * @brief ヒープを空にし，キーの下限を0に戻す。
+   */
+  void clear() {
+    for (auto &bucket : buckets_) bucket.clear();
+    size_ = 0;
+    last_ = 0;
+  }
+
+private:
+  std::vector<std::pair<UKey, Value>> buckets_[N_BUCKETS];
+  int size_;
+  UKey last_;
+
+  int bucket_(UKey k) const {
+    if (k == last_) return 0;
+    return N_BUCKETS - 1 - __builtin_clzll(static_cast<unsigned long long>(k ^ last_))
+           + (std::numeric_limits<unsigned long long>::digits - std::numeric_limits<UKey>::digits);
+  }
+};
@@ -1,30 +1,318 @@
+/**
+ * @file runlength.hpp
+ * @brief ランレングス符号化に関するコード
+ * @details
+ * * runlength
+ *   * 区間を符号化し，(値，連続数)の配列を返す．
+ * * RunLengthView
+ *   * 入力イテレータ上の遅延評価レンジ．要素を1度だけ読みながら(値，連続数)を順に生成する．
+ * * RunLengthEncoder
+ *   * チャンク単位でデータを受け取り，チャンク境界を跨ぐ連続も正しく扱うストリーミング符号化器．
+ *   * バイト列に対しては，AVX2が有効なら32バイトずつ比較して連続の境界を探す．
+ * * runlength_decode / RunLengthDecoder
+ *   * 符号化結果を復号する．
+ */
 #ifndef OKINA_RUNLENGTH
 #define OKINA_RUNLENGTH
 
-#include <string>
-#include <typeinfo>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
-template <typename T, class ForwardIterator>
-std::vector<std::pair<T, int>> runlength(ForwardIterator first, ForwardIterator last) {
-  assert(typeid(T) == typeid(*first));
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace runlength_internal {
+
+/**
+ * @brief data[0, len)のうち，先頭からvalと等しい要素が何個連続するかを返す．
+ */
+template <typename T>
+std::size_t count_run(const T *data, std::size_t len, const T &val) {
+  std::size_t i = 0;
+  while (i < len && data[i] == val) ++i;
+  return i;
+}
+
+#ifdef __AVX2__
+/**
+ * @brief バイト列用の特殊化．32バイトずつ比較し，最初に一致しない位置を求める．
+ */
+inline std::size_t count_run_bytes(const unsigned char *data, std::size_t len, unsigned char val) {
+  const __m256i pattern = _mm256_set1_epi8(static_cast<char>(val));
+  std::size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+    unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern)));
+    if (mask != 0xffffffffu) return i + __builtin_ctz(~mask);
+  }
+  while (i < len && data[i] == val) ++i;
+  return i;
+}
+
+template <>
+inline std::size_t count_run<unsigned char>(const unsigned char *data, std::size_t len, const unsigned char &val) {
+  return count_run_bytes(data, len, val);
+}
+
+template <>
+inline std::size_t count_run<char>(const char *data, std::size_t len, const char &val) {
+  return count_run_bytes(reinterpret_cast<const unsigned char *>(data), len, static_cast<unsigned char>(val));
+}
+
+template <>
+inline std::size_t count_run<signed char>(const signed char *data, std::size_t len, const signed char &val) {
+  return count_run_bytes(reinterpret_cast<const unsigned char *>(data), len, static_cast<unsigned char>(val));
+}
+#endif
+
+} // namespace runlength_internal
+
+/**
+ * @brief 入力イテレータ上のランレングス符号化を遅延評価するレンジ．
+ * @details 各要素を1度だけ読むので，std::istream_iteratorのような入力イテレータにも使える．
+ *   範囲for文で(値，連続数)のpairを順に受け取れる．
+ * @tparam InputIterator 入力イテレータの型．
+ */
+template <class InputIterator>
+class RunLengthView {
+public:
+  using value_type = typename std::iterator_traits<InputIterator>::value_type;
+  using Run = std::pair<value_type, long long>;
+
+  class iterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Run;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Run *;
+    using reference = const Run &;
+
+    iterator() : cur_(), last_(), at_end_(true) {}
+
+    iterator(InputIterator first, InputIterator last) : cur_(first), last_(last), at_end_(false) {
+      advance_();
+    }
+
+    reference operator*() const { return run_; }
+    pointer operator->() const { return &run_; }
+
+    iterator &operator++() {
+      advance_();
+      return *this;
+    }
+
+    void operator++(int) { advance_(); }
+
+    bool operator==(const iterator &right) const { return at_end_ && right.at_end_; }
+    bool operator!=(const iterator &right) const { return !(*this == right); }
+
+  private:
+    InputIterator cur_, last_;
+    Run run_;
+    bool at_end_;
+
+    void advance_() {
+      if (cur_ == last_) {
+        at_end_ = true;
+        return;
+      }
+      run_.first = *cur_;
+      run_.second = 1;
+      for (++cur_; cur_ != last_; ++cur_) {
+        if (!(*cur_ == run_.first)) break;
+        ++run_.second;
+      }
+    }
+  };
+
+  RunLengthView(InputIterator first, InputIterator last) : first_(first), last_(last) {}
+
+  iterator begin() const { return iterator(first_, last_); }
+  iterator end() const { return iterator(); }
+
+private:
+  InputIterator first_, last_;
+};
+
+/**
+ * @brief RunLengthViewを作る．
+ */
+template <class InputIterator>
+RunLengthView<InputIterator> runlength_view(InputIterator first, InputIterator last) {
+  return RunLengthView<InputIterator>(first, last);
+}
+
+/**
+ * @brief firstからlastをランレングス符号化する．O(n)
+ *
+ * @param first 区間の先頭
+ * @param last 区間の末尾
+ * @return (値，連続数)で構成される配列．区間が空なら空配列
+ */
+template <typename T, class InputIterator>
+std::vector<std::pair<T, int>> runlength(InputIterator first, InputIterator last) {
   std::vector<std::pair<T, int>> ret;
-  T val = *first;
-  int cnt = 1;
-
-  auto iter = first;
-  ++iter;
-  for (; iter != last; ++iter) {
-    if (*iter == val) ++cnt;
-    else {
-      ret.emplace_back(val, cnt);
-      val = *iter;
-      cnt = 1;
+  for (const auto &[val, cnt] : runlength_view(first, last)) {
+    ret.emplace_back(val, static_cast<int>(cnt));
+  }
+  return ret;
+}
+
+/**
+ * @brief チャンク単位でデータを受け取るランレングス符号化器．
+ * @details 連続が終了した時点でコールバックに(値，連続数)を渡す．
+ *   最後の連続はflush()を呼んだ時点で渡される．
+ *   メモリ使用量はチャンクのサイズによらずO(1)．
+ * @tparam T 要素の型．
+ * @tparam Callback void(const T &, long long)として呼び出せる型．
+ */
+template <typename T, class Callback>
+class RunLengthEncoder {
+public:
+  explicit RunLengthEncoder(Callback callback) : callback_(std::move(callback)) {}
+
+  /**
+   * @brief 連続した要素列data[0, len)を符号化する．
+   */
+  void feed(const T *data, std::size_t len) {
+    std::size_t i = 0;
+    while (i < len) {
+      if (!has_run_) {
+        val_ = data[i];
+        cnt_ = 0;
+        has_run_ = true;
+      }
+      std::size_t run = runlength_internal::count_run(data + i, len - i, val_);
+      cnt_ += run;
+      i += run;
+      if (i < len) emit_();
     }
   }
-  ret.emplace_back(val, cnt);
 
+  void feed(const std::vector<T> &chunk) { feed(chunk.data(), chunk.size()); }
+
+  /**
+   * @brief 途中の連続をコールバックに渡す．入力の終端で呼ぶ．
+   */
+  void flush() {
+    if (has_run_) emit_();
+  }
+
+private:
+  Callback callback_;
+  T val_{};
+  long long cnt_ = 0;
+  bool has_run_ = false;
+
+  void emit_() {
+    callback_(static_cast<const T &>(val_), cnt_);
+    has_run_ = false;
+  }
+};
+
+template <typename T, class Callback>
+RunLengthEncoder<T, Callback> make_runlength_encoder(Callback callback) {
+  return RunLengthEncoder<T, Callback>(std::move(callback));
+}
+
+/**
+ * @brief ファイルの内容をバイト列としてランレングス符号化する．
+ * @details buffer_size バイトずつ読み込むので，ファイルがメモリに乗らなくてもよい．
+ *
+ * @param fp 読み込むファイル
+ * @param callback void(unsigned char, long long)として呼び出せるコールバック
+ * @param buffer_size 読み込みバッファのサイズ
+ * @return 読み込みエラーが起きなければtrue
+ */
+template <class Callback>
+bool runlength_encode_file(std::FILE *fp, Callback callback, std::size_t buffer_size = 1 << 16) {
+  std::vector<unsigned char> buf(buffer_size);
+  auto encoder = make_runlength_encoder<unsigned char>(
+    [&callback](const unsigned char &val, long long cnt) { callback(val, cnt); }
+  );
+  std::size_t len;
+  while ((len = std::fread(buf.data(), 1, buf.size(), fp)) > 0) {
+    encoder.feed(buf.data(), len);
+  }
+  encoder.flush();
+  return !std::ferror(fp);
+}
+
+/**
+ * @brief ランレングス符号化された列を復号し，出力イテレータに書き込む．O(復号後の長さ)
+ *
+ * @param first (値，連続数)の列の先頭
+ * @param last (値，連続数)の列の末尾
+ * @param out 出力イテレータ
+ * @return 書き込み終了位置
+ */
+template <class InputIterator, class OutputIterator>
+OutputIterator runlength_decode(InputIterator first, InputIterator last, OutputIterator out) {
+  for (; first != last; ++first) {
+    const auto &[val, cnt] = *first;
+    out = std::fill_n(out, cnt, val);
+  }
+  return out;
+}
+
+/**
+ * @brief ランレングス符号化された列を復号し，vectorで返す．
+ */
+template <typename T, typename CountType>
+std::vector<T> runlength_decode(const std::vector<std::pair<T, CountType>> &runs) {
+  std::size_t total = 0;
+  for (const auto &run : runs) total += run.second;
+  std::vector<T> ret;
+  ret.reserve(total);
+  runlength_decode(runs.begin(), runs.end(), std::back_inserter(ret));
   return ret;
 }
 
-#endif
\ No newline at end of file
+/**
+ * @brief (値，連続数)を受け取り，復号結果をチャンク単位でコールバックに渡すストリーミング復号器．
+ * @details 長い連続もbuffer_size要素ずつに分けて渡すので，メモリ使用量はバッファ分のみ．
+ * @tparam T 要素の型．
+ * @tparam Callback void(const T *, std::size_t)として呼び出せる型．
+ */
+template <typename T, class Callback>
+class RunLengthDecoder {
+public:
+  RunLengthDecoder(Callback callback, std::size_t buffer_size = 1 << 16)
+    : callback_(std::move(callback)) {
+    buf_.reserve(std::max<std::size_t>(buffer_size, 1));
+  }
+
+  void feed(const T &val, long long cnt) {
+    while (cnt > 0) {
+      std::size_t room = buf_.capacity() - buf_.size();
+      std::size_t len = static_cast<std::size_t>(std::min<long long>(cnt, room));
+      buf_.insert(buf_.end(), len, val);
+      cnt -= len;
+      if (buf_.size() == buf_.capacity()) flush();
+    }
+  }
+
+  void flush() {
+    if (buf_.empty()) return;
+    callback_(static_cast<const T *>(buf_.data()), buf_.size());
+    buf_.clear();
+  }
+
+private:
+  Callback callback_;
+  std::vector<T> buf_;
+};
+
+template <typename T, class Callback>
+RunLengthDecoder<T, Callback> make_runlength_decoder(Callback callback, std::size_t buffer_size = 1 << 16) {
+  return RunLengthDecoder<T, Callback>(std::move(callback), buffer_size);
+}
+
+#endif // OKINA_RUNLENGTH